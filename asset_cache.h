@@ -0,0 +1,264 @@
+#ifndef ASSET_CACHE_H
+#define ASSET_CACHE_H
+
+// Cache des textures du jeu, indexé par chemin de fichier : chaque image n'est chargée qu'une fois,
+// quel que soit le nombre d'objets qui l'utilisent. Les petits sprites (personnages, boutons, icônes)
+// sont regroupés dans un atlas unique, pour qu'une image du jeu n'utilise qu'une seule texture.
+//
+// Preload() lance le décodage des images et la lecture des fichiers audio sur le pool de threads partagé
+// (job_system.h) dès l'ouverture de la fenêtre ; le thread principal ne fait plus que l'envoi à la carte graphique.
+
+#include <raylib.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include "job_system.h"
+
+// Image à dessiner : une texture et la zone de cette texture occupée par l'image
+struct Sprite {
+    Texture2D texture;  // Texture contenant l'image (l'atlas pour les petits sprites)
+    Rectangle source;   // Zone de l'image dans la texture
+};
+
+// Petits sprites regroupés dans l'atlas. Les grandes images (fonds d'écran) et la texture des murs,
+// répétée le long des segments, restent des textures séparées.
+static const char* const ATLAS_SPRITES[] = {
+    "Tom.png", "jerry.png", "Spike.png", "magana.png",
+    "reset.png", "home.png", "pause60.png", "resume60.png"
+};
+
+class AssetCache {
+private:
+    // Texture chargée et nombre d'utilisateurs
+    struct Entry {
+        Texture2D texture;
+        int references;
+    };
+
+    static const int ATLAS_PADDING = 2;  // Marge entre deux sprites de l'atlas (évite les débordements au filtrage)
+
+    std::map<std::string, Entry> textures;   // Textures séparées, par chemin
+    Entry atlas;                             // Atlas des petits sprites
+    std::map<std::string, Rectangle> regions; // Zone de chaque sprite dans l'atlas
+    int loads;                               // Nombre de fichiers lus depuis le disque
+
+    // Préchargement : images décodées et fichiers lus par les threads de travail, en attente d'utilisation
+    std::map<std::string, JobFuture<Image>> pendingImages;
+    std::map<std::string, JobFuture<std::vector<unsigned char>>> pendingFiles;
+    std::map<std::string, std::vector<unsigned char>> musicData;  // Données des musiques en cours de lecture
+    std::chrono::steady_clock::time_point preloadStart;  // Lancement du préchargement (ouverture de la fenêtre)
+    double waitMs;                           // Temps passé par le thread principal à attendre un préchargement
+
+    // Lit un fichier entier en mémoire (sans raylib, utilisable depuis un thread de travail)
+    static std::vector<unsigned char> ReadFileBytes(const std::string& path) {
+        std::vector<unsigned char> bytes;
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) return bytes;
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size > 0) {
+            bytes.resize(size);
+            bytes.resize(fread(bytes.data(), 1, bytes.size(), file));
+        }
+        fclose(file);
+        return bytes;
+    }
+
+    // Attend le résultat d'un préchargement en comptant le temps d'attente du thread principal
+    template <typename T>
+    T Wait(JobFuture<T>& pending) {
+        auto start = std::chrono::steady_clock::now();
+        T result = pending.Get();
+        waitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+    // Image décodée du fichier donné : celle du préchargement si elle existe, sinon décodée maintenant
+    Image TakeImage(const char* path) {
+        loads++;
+        auto found = pendingImages.find(path);
+        if (found == pendingImages.end()) return LoadImage(path);
+        Image image = Wait(found->second);
+        pendingImages.erase(found);
+        return image;
+    }
+
+    // Texture du fichier donné, envoyée à la carte graphique depuis l'image décodée
+    Texture2D UploadTexture(const char* path) {
+        Image image = TakeImage(path);
+        Texture2D texture = LoadTextureFromImage(image);
+        UnloadImage(image);
+        return texture;
+    }
+
+    static bool IsAtlasSprite(const char* path) {
+        for (const char* sprite : ATLAS_SPRITES) {
+            if (strcmp(sprite, path) == 0) return true;
+        }
+        return false;
+    }
+
+    // Charge tous les petits sprites et les range par étagères dans une seule image, envoyée une fois à la carte graphique
+    void BuildAtlas() {
+        const int count = sizeof(ATLAS_SPRITES) / sizeof(ATLAS_SPRITES[0]);
+        std::vector<Image> images(count);
+        std::vector<int> order(count);
+        for (int i = 0; i < count; i++) {
+            images[i] = TakeImage(ATLAS_SPRITES[i]);
+            order[i] = i;
+        }
+
+        // Rangement par étagères : les sprites les plus hauts d'abord, de gauche à droite
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return images[a].height > images[b].height; });
+        const int atlasWidth = 256;
+        int x = ATLAS_PADDING, y = ATLAS_PADDING, shelfHeight = 0;
+        std::vector<Rectangle> placed(count);
+        for (int i : order) {
+            if (x + images[i].width + ATLAS_PADDING > atlasWidth) {
+                x = ATLAS_PADDING;
+                y += shelfHeight + ATLAS_PADDING;
+                shelfHeight = 0;
+            }
+            placed[i] = {(float)x, (float)y, (float)images[i].width, (float)images[i].height};
+            x += images[i].width + ATLAS_PADDING;
+            shelfHeight = std::max(shelfHeight, images[i].height);
+        }
+        int atlasHeight = y + shelfHeight + ATLAS_PADDING;
+
+        Image atlasImage = GenImageColor(atlasWidth, atlasHeight, BLANK);
+        for (int i = 0; i < count; i++) {
+            ImageDraw(&atlasImage, images[i], {0, 0, (float)images[i].width, (float)images[i].height}, placed[i], WHITE);
+            regions[ATLAS_SPRITES[i]] = placed[i];
+            UnloadImage(images[i]);
+        }
+        atlas.texture = LoadTextureFromImage(atlasImage);
+        UnloadImage(atlasImage);
+        TraceLog(LOG_INFO, "ASSETS: atlas %dx%d pour %d sprites", atlasWidth, atlasHeight, count);
+    }
+
+public:
+    AssetCache() : atlas{}, loads(0), preloadStart(std::chrono::steady_clock::now()), waitMs(0) {}
+
+    // Lance le décodage des images et la lecture des fichiers audio donnés, un travail du pool par fichier.
+    // Les textures sont créées plus tard, sur le thread principal, à leur première utilisation.
+    void Preload(const std::vector<const char*>& imagePaths, const std::vector<const char*>& filePaths) {
+        preloadStart = std::chrono::steady_clock::now();
+        for (const char* path : imagePaths) {
+            std::string file = path;
+            if (pendingImages.count(file) || textures.count(file)) continue;
+            pendingImages[file] = JobFuture<Image>::Async([file]() { return LoadImage(file.c_str()); });
+        }
+        for (const char* path : filePaths) {
+            std::string file = path;
+            if (pendingFiles.count(file)) continue;
+            pendingFiles[file] = JobFuture<std::vector<unsigned char>>::Async([file]() { return ReadFileBytes(file); });
+        }
+    }
+
+    // Musique lue depuis les données préchargées (ou lues maintenant si le fichier n'a pas été préchargé).
+    // Les données restent en mémoire jusqu'à UnloadMusic, le flux audio les lisant au fur et à mesure.
+    Music LoadMusic(const char* path) {
+        std::vector<unsigned char>& data = musicData[path];
+        auto found = pendingFiles.find(path);
+        if (found != pendingFiles.end()) {
+            data = Wait(found->second);
+            pendingFiles.erase(found);
+        } else {
+            data = ReadFileBytes(path);
+        }
+        return LoadMusicStreamFromMemory(GetFileExtension(path), data.data(), (int)data.size());
+    }
+
+    // Arrête et libère une musique obtenue par LoadMusic, ainsi que ses données
+    void UnloadMusic(const char* path, Music music) {
+        UnloadMusicStream(music);
+        musicData.erase(path);
+    }
+
+    // Texture séparée du fichier donné, chargée au premier appel puis partagée
+    Texture2D AcquireTexture(const char* path) {
+        auto found = textures.find(path);
+        if (found == textures.end()) {
+            found = textures.insert(std::make_pair(std::string(path), Entry{UploadTexture(path), 0})).first;
+        }
+        found->second.references++;
+        return found->second.texture;
+    }
+
+    // Sprite du fichier donné : une zone de l'atlas pour les petits sprites, sinon la texture entière
+    Sprite AcquireSprite(const char* path) {
+        if (IsAtlasSprite(path)) {
+            if (atlas.texture.id == 0) BuildAtlas();
+            atlas.references++;
+            return Sprite{atlas.texture, regions[path]};
+        }
+        Texture2D texture = AcquireTexture(path);
+        return Sprite{texture, {0, 0, (float)texture.width, (float)texture.height}};
+    }
+
+    // Signale que l'appelant n'utilise plus la texture ou le sprite du fichier donné.
+    // La texture reste en mémoire jusqu'à UnloadUnused(), pour qu'une nouvelle partie la retrouve sans relecture.
+    void Release(const char* path) {
+        if (IsAtlasSprite(path)) {
+            if (atlas.references > 0) atlas.references--;
+            return;
+        }
+        auto found = textures.find(path);
+        if (found != textures.end() && found->second.references > 0) found->second.references--;
+    }
+
+    // Libère les textures qui ne sont plus utilisées par personne
+    void UnloadUnused() {
+        for (auto it = textures.begin(); it != textures.end();) {
+            if (it->second.references == 0) {
+                UnloadTexture(it->second.texture);
+                it = textures.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (atlas.texture.id != 0 && atlas.references == 0) {
+            UnloadTexture(atlas.texture);
+            atlas.texture = Texture2D{};
+            regions.clear();
+        }
+    }
+
+    // Libère toutes les textures, les préchargements et les données des musiques ; à appeler avant CloseWindow(),
+    // une fois les flux audio arrêtés (ils lisent leurs données au fur et à mesure)
+    void UnloadAll() {
+        for (auto& pending : pendingImages) UnloadImage(pending.second.Get());  // Images préchargées jamais utilisées
+        pendingImages.clear();
+        pendingFiles.clear();
+        musicData.clear();  // Données des musiques dont UnloadMusic n'a pas été appelé
+        for (auto& entry : textures) UnloadTexture(entry.second.texture);
+        textures.clear();
+        if (atlas.texture.id != 0) UnloadTexture(atlas.texture);
+        atlas = Entry{};
+        regions.clear();
+    }
+
+    // Nombre de fichiers image lus depuis le disque depuis le lancement
+    int GetLoadCount() const { return loads; }
+
+    // Temps écoulé depuis le lancement du préchargement (en millisecondes)
+    double GetMsSincePreload() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - preloadStart).count();
+    }
+
+    // Temps total passé par le thread principal à attendre les threads de travail (en millisecondes)
+    double GetWaitMs() const { return waitMs; }
+};
+
+// Cache partagé par tout le jeu (les textures sont libérées explicitement par UnloadAll)
+inline AssetCache& Assets() {
+    static AssetCache cache;
+    return cache;
+}
+
+#endif
@@ -0,0 +1,188 @@
+// Benchmark du générateur de labyrinthe : mesure le débit (cellules par seconde)
+// de MazeGrid::GeneratePath pour des grilles de 20x15 à 4096x4096, puis le nombre
+// d'appels de dessin économisés par la fusion des murs (WallMesh), compare les algorithmes
+// de génération (débit, mémoire maximale, impasses, longueur de la solution), mesure le calcul
+// du champ de distances vers la sortie, la re-génération locale d'une fenêtre, le déplacement
+// des obstacles et enfin la génération par tuiles d'une grille 8192x8192 de 1 à N threads.
+// Compilé sans raylib : make bench && ./bench
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "maze_grid.h"
+#include "wall_mesh.h"
+#include "maze_generators.h"
+#include "maze_stats.h"
+#include "tiled_maze.h"
+#include "distance_field.h"
+#include "obstacle_swarm.h"
+
+using namespace std;
+
+int main() {
+    // Tailles de grille testées (la première correspond au labyrinthe du jeu)
+    const int sizes[][2] = {
+        {20, 15}, {64, 64}, {256, 256}, {1024, 1024}, {2048, 2048}, {4096, 4096}
+    };
+    const double minSeconds = 0.5;  // Durée minimale de mesure par taille
+
+    Rng random(1234);  // Graine fixe pour que deux exécutions soient comparables
+
+    printf("%-12s %12s %8s %12s %14s %12s\n", "grille", "cellules", "essais", "ms/essai", "cellules/s", "octets");
+    for (const auto& size : sizes) {
+        int width = size[0];
+        int height = size[1];
+        MazeGrid grid(width, height);
+
+        int runs = 0;
+        double elapsed = 0.0;
+        while (elapsed < minSeconds || runs == 0) {
+            grid.Reset();
+            auto start = chrono::steady_clock::now();
+            grid.GeneratePath(0, 0, random);
+            auto end = chrono::steady_clock::now();
+            elapsed += chrono::duration<double>(end - start).count();
+            runs++;
+        }
+
+        double cells = (double)width * height;
+        printf("%5dx%-6d %12.0f %8d %12.3f %14.0f %12zu\n",
+               width, height, cells, runs, elapsed * 1000.0 / runs, cells * runs / elapsed, grid.MemoryBytes());
+    }
+
+    printf("\n%-12s %12s %12s %12s %12s\n", "grille", "quads/cell", "segments", "economises", "ms/build");
+    for (const auto& size : sizes) {
+        MazeGrid grid(size[0], size[1]);
+        grid.GeneratePath(0, 0, random);
+
+        WallMesh mesh;
+        auto start = chrono::steady_clock::now();
+        mesh.Build(grid);
+        auto end = chrono::steady_clock::now();
+
+        printf("%5dx%-6d %12d %12d %12d %12.3f\n", size[0], size[1],
+               mesh.GetCellSegments(), mesh.GetRunCount(), mesh.GetDrawCallsSaved(),
+               chrono::duration<double>(end - start).count() * 1000.0);
+    }
+
+    // Comparaison des algorithmes : tailles plus modestes, Wilson devenant lent sur les très grandes grilles
+    const int algorithmSizes[][2] = {{64, 64}, {256, 256}, {1024, 1024}};
+    printf("\n%-12s %-13s %8s %12s %14s %12s %10s %10s %8s\n",
+           "grille", "algorithme", "essais", "ms/essai", "cellules/s", "octets max", "impasses", "solution", "parfait");
+    for (const auto& size : algorithmSizes) {
+        for (int algorithm = 0; algorithm < ALGORITHM_COUNT; algorithm++) {
+            MazeGrid grid;
+            MazeGenerator generator;  // Nouveau générateur : ses tampons ne reflètent que cet algorithme
+
+            int runs = 0;
+            double elapsed = 0.0;
+            while (elapsed < minSeconds || runs == 0) {
+                MazeId id = {(uint64_t)(1234 + runs), size[0], size[1], (MazeAlgorithm)algorithm};
+                auto start = chrono::steady_clock::now();
+                generator.Generate(grid, id);
+                auto end = chrono::steady_clock::now();
+                elapsed += chrono::duration<double>(end - start).count();
+                runs++;
+            }
+
+            MazeStats stats = ComputeMazeStats(grid);
+            double cells = (double)size[0] * size[1];
+            size_t peakBytes = grid.MemoryBytes() + grid.ScratchBytes() + generator.ScratchBytes();
+            printf("%5dx%-6d %-13s %8d %12.3f %14.0f %12zu %9.1f%% %10d %8s\n",
+                   size[0], size[1], MazeAlgorithmName((MazeAlgorithm)algorithm), runs, elapsed * 1000.0 / runs,
+                   cells * runs / elapsed, peakBytes, stats.deadEndRatio * 100.0, stats.solutionLength,
+                   stats.perfect ? "oui" : "non");
+        }
+    }
+
+    // Champ de distances vers la sortie : calculé une fois par labyrinthe, puis lu en temps constant
+    printf("\n%-12s %12s %14s %12s %10s\n", "grille", "ms/build", "cellules/s", "octets", "solution");
+    for (const auto& size : sizes) {
+        MazeGrid grid(size[0], size[1]);
+        grid.GeneratePath(0, 0, random);
+
+        DistanceField field;
+        auto start = chrono::steady_clock::now();
+        field.Build(grid, size[0] - 1, size[1] - 1);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        printf("%5dx%-6d %12.3f %14.0f %12zu %10u\n", size[0], size[1], ms,
+               (double)size[0] * size[1] * 1000.0 / ms, field.MemoryBytes(), field.GetDistance(0, 0));
+    }
+
+    // Re-génération locale : une fenêtre de k x k cellules et ses distances, comparée à une génération complète
+    const int regionGridSizes[] = {1024, 4096};
+    const int regionSizes[] = {16, 32, 64};
+    printf("\n%-12s %8s %12s %12s %8s\n", "grille", "fenêtre", "us/fenêtre", "ms complet", "parfait");
+    for (int gridSize : regionGridSizes) {
+        MazeGrid grid;
+        MazeGenerator generator;
+        DistanceField field;
+        auto start = chrono::steady_clock::now();
+        generator.Generate(grid, MazeId{1234, gridSize, gridSize, BACKTRACKER});
+        field.Build(grid, gridSize - 1, gridSize - 1);
+        double fullMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        for (int size : regionSizes) {
+            const int runs = 200;
+            start = chrono::steady_clock::now();
+            for (int run = 0; run < runs; run++) {
+                int x0 = random.Range(0, gridSize - size), y0 = random.Range(0, gridSize - size);
+                generator.RegenerateRegion(grid, x0, y0, x0 + size, y0 + size, random, gridSize - 1, gridSize - 1);
+                field.UpdateRegion(grid, x0, y0, x0 + size, y0 + size);
+            }
+            double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / runs;
+            printf("%5dx%-6d %5dx%-3d %12.1f %12.1f %8s\n", gridSize, gridSize, size, size, us, fullMs,
+                   gridSize <= 1024 ? (ComputeMazeStats(grid).perfect ? "oui" : "non") : "-");
+        }
+    }
+
+    // Déplacement des obstacles le long des couloirs : durée d'un pas de déplacement de tout l'essaim
+    const int swarmSize = 1024;
+    const int swarmCounts[] = {1000, 10000, 100000};
+    const char* const mixNames[] = {"errance", "ronde", "poursuite", "mélange"};
+    const vector<ObstacleBehavior> mixes[] = {{WANDER}, {PATROL}, {CHASE}, {CHASE, PATROL, WANDER}};
+    MazeGrid swarmGrid(swarmSize, swarmSize);
+    swarmGrid.GeneratePath(0, 0, random);
+    printf("\n%-12s %10s %-11s %12s %12s\n", "grille", "obstacles", "comportement", "us/pas", "octets");
+    for (int count : swarmCounts) {
+        for (int mix = 0; mix < 4; mix++) {
+            ObstacleSwarm swarm(1.0f, 1234);
+            swarm.Spawn(count, swarmSize, swarmSize, mixes[mix]);
+            const int ticks = 200;
+            auto start = chrono::steady_clock::now();
+            for (int tick = 0; tick < ticks; tick++) {
+                swarm.BeginStep();
+                swarm.Move(1.0f, swarmGrid, swarmSize / 2 + tick % 8, swarmSize / 2);  // Le joueur bouge à chaque pas
+            }
+            double us = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / ticks;
+            printf("%5dx%-6d %10d %-11s %12.1f %12zu\n", swarmSize, swarmSize, count, mixNames[mix], us, swarm.MemoryBytes());
+        }
+    }
+
+    // Génération par tuiles : de 1 thread au nombre de cœurs (puissances de deux, puis le nombre de cœurs).
+    // L'empreinte doit être la même sur chaque ligne : le labyrinthe ne dépend pas du nombre de threads.
+    const int tiledSize = 8192;
+    int maxThreads = max(1, (int)thread::hardware_concurrency());
+    vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    printf("\n%-12s %8s %12s %14s %10s %18s %8s\n", "grille", "threads", "ms", "cellules/s", "speedup", "empreinte", "parfait");
+    MazeGrid tiledGrid;
+    double baseMs = 0.0;
+    for (int threads : threadCounts) {
+        TiledMazeGenerator generator(threads);
+        MazeId id = {1234, tiledSize, tiledSize, BACKTRACKER};
+        auto start = chrono::steady_clock::now();
+        generator.Generate(tiledGrid, id);
+        auto end = chrono::steady_clock::now();
+        double ms = chrono::duration<double, milli>(end - start).count();
+        if (threads == 1) baseMs = ms;
+
+        MazeStats stats = ComputeMazeStats(tiledGrid);
+        printf("%5dx%-6d %8d %12.1f %14.0f %9.2fx   %016llx %8s\n", tiledSize, tiledSize, threads, ms,
+               (double)tiledSize * tiledSize * 1000.0 / ms, baseMs / ms, (unsigned long long)tiledGrid.Checksum(),
+               stats.perfect ? "oui" : "non");
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+#ifndef CHUNKED_MAZE_H
+#define CHUNKED_MAZE_H
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "maze_grid.h"
+#include "maze_generators.h"
+
+// Labyrinthe infini découpé en blocs carrés de CHUNK_SIZE cellules, générés à la demande.
+//
+// Chaque bloc est un labyrinthe parfait dont la graine ne dépend que de la graine du monde et de
+// ses coordonnées : un bloc évincé peut être régénéré à l'identique au lieu d'être conservé.
+// Deux blocs voisins sont reliés par une porte dont la position est tirée d'un hachage de leur
+// arête commune ; les deux blocs ouvrent donc la même porte sans jamais se consulter.
+// Le nombre de blocs en mémoire est borné : au-delà, le bloc utilisé le moins récemment est évincé.
+class ChunkedMaze {
+public:
+    static const int CHUNK_SIZE = 16;  // Côté d'un bloc (en cellules)
+
+private:
+    // Bloc chargé dans un emplacement de la réserve
+    struct Chunk {
+        int cx, cy;             // Coordonnées du bloc
+        MazeGrid grid;          // Murs du bloc, portes comprises
+        unsigned long long lastUsed;  // Dernière utilisation (pour l'éviction du moins récemment utilisé)
+        bool loaded;            // Emplacement occupé
+    };
+
+    uint64_t seed;                              // Graine du monde
+    MazeAlgorithm algorithm;                    // Algorithme de génération des blocs
+    std::vector<Chunk> chunks;                  // Réserve de taille fixe (plafond mémoire)
+    std::unordered_map<uint64_t, int> index;    // Coordonnées du bloc -> emplacement dans la réserve
+    MazeGenerator generator;                    // Tampons de génération partagés par tous les blocs
+    unsigned long long clock;                   // Compteur d'utilisations
+    long long generated;                        // Nombre total de blocs générés (régénérations comprises)
+
+    static uint64_t Key(int cx, int cy) {
+        return ((uint64_t)(uint32_t)cx << 32) | (uint32_t)cy;
+    }
+
+    // Hachage de la graine du monde, de coordonnées et d'un sel (mélange de splitmix64)
+    uint64_t Hash(int cx, int cy, uint64_t salt) const {
+        uint64_t z = seed ^ (Key(cx, cy) * 0x9E3779B97F4A7C15ULL) ^ (salt * 0xD6E8FEB86659FD93ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Position de la porte entre le bloc (cx, cy) et son voisin de droite (vertical = false)
+    // ou son voisin du dessous (vertical = true)
+    int Door(int cx, int cy, bool vertical) const {
+        return (int)(Hash(cx, cy, vertical ? 2 : 1) % CHUNK_SIZE);
+    }
+
+    // Génère le bloc (cx, cy) dans l'emplacement donné, puis ouvre ses quatre portes
+    void Generate(Chunk& chunk, int cx, int cy) {
+        chunk.cx = cx;
+        chunk.cy = cy;
+        chunk.loaded = true;
+        generator.Generate(chunk.grid, MazeId{Hash(cx, cy, 0), CHUNK_SIZE, CHUNK_SIZE, algorithm});
+        chunk.grid.RemoveWall(CHUNK_SIZE - 1, Door(cx, cy, false), MazeGrid::RIGHT);   // Vers le bloc de droite
+        chunk.grid.RemoveWall(0, Door(cx - 1, cy, false), MazeGrid::LEFT);             // Vers le bloc de gauche
+        chunk.grid.RemoveWall(Door(cx, cy, true), CHUNK_SIZE - 1, MazeGrid::DOWN);     // Vers le bloc du dessous
+        chunk.grid.RemoveWall(Door(cx, cy - 1, true), 0, MazeGrid::UP);                // Vers le bloc du dessus
+        generated++;
+    }
+
+public:
+    // maxChunks fixe le plafond mémoire ; il doit dépasser le nombre de blocs visibles à l'écran
+    ChunkedMaze(uint64_t seed, MazeAlgorithm algorithm = BACKTRACKER, int maxChunks = 64)
+        : seed(seed), algorithm(algorithm), chunks(maxChunks), clock(0), generated(0) {
+        for (Chunk& chunk : chunks) {
+            chunk.grid.Resize(CHUNK_SIZE, CHUNK_SIZE);  // Toute la mémoire des blocs est allouée ici
+            chunk.loaded = false;
+            chunk.lastUsed = 0;
+        }
+        index.reserve(maxChunks * 2);
+    }
+
+    // Coordonnée du bloc contenant la cellule de coordonnée c (division arrondie vers le bas)
+    static int ChunkCoord(int c) {
+        return c >= 0 ? c / CHUNK_SIZE : -((-c + CHUNK_SIZE - 1) / CHUNK_SIZE);
+    }
+
+    // Murs du bloc (cx, cy), généré s'il n'est pas en mémoire (en évinçant le bloc le moins récemment utilisé)
+    const MazeGrid& GetChunk(int cx, int cy) {
+        clock++;
+        auto found = index.find(Key(cx, cy));
+        if (found != index.end()) {
+            chunks[found->second].lastUsed = clock;
+            return chunks[found->second].grid;
+        }
+
+        int slot = 0;
+        for (int i = 0; i < (int)chunks.size(); i++) {
+            if (!chunks[i].loaded) { slot = i; break; }
+            if (chunks[i].lastUsed < chunks[slot].lastUsed) slot = i;
+        }
+        Chunk& chunk = chunks[slot];
+        if (chunk.loaded) index.erase(Key(chunk.cx, chunk.cy));
+        Generate(chunk, cx, cy);
+        chunk.lastUsed = clock;
+        index[Key(cx, cy)] = slot;
+        return chunk.grid;
+    }
+
+    // Vérifie s'il y a un mur dans la direction (dx, dy) depuis la cellule (x, y) du monde
+    bool HasWall(int x, int y, int dx, int dy) {
+        int cx = ChunkCoord(x), cy = ChunkCoord(y);
+        return GetChunk(cx, cy).HasWall(x - cx * CHUNK_SIZE, y - cy * CHUNK_SIZE, dx, dy);
+    }
+
+    // Charge à l'avance les blocs situés à moins de radius cellules de (x, y)
+    void Prefetch(int x, int y, int radius) {
+        for (int cy = ChunkCoord(y - radius); cy <= ChunkCoord(y + radius); cy++) {
+            for (int cx = ChunkCoord(x - radius); cx <= ChunkCoord(x + radius); cx++) {
+                GetChunk(cx, cy);
+            }
+        }
+    }
+
+    // Statistiques : blocs en mémoire, blocs générés depuis le début, mémoire réservée (en octets)
+    int GetLoadedCount() const { return (int)index.size(); }
+    long long GetGeneratedCount() const { return generated; }
+    int GetCapacity() const { return (int)chunks.size(); }
+    size_t MemoryBytes() const {
+        size_t bytes = chunks.size() * sizeof(Chunk) + generator.ScratchBytes();
+        for (const Chunk& chunk : chunks) bytes += chunk.grid.MemoryBytes() + chunk.grid.ScratchBytes();
+        return bytes;
+    }
+    uint64_t GetSeed() const { return seed; }
+};
+
+#endif
@@ -0,0 +1,296 @@
+#ifndef DIFFICULTY_H
+#define DIFFICULTY_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include "maze_grid.h"
+#include "rng.h"
+
+// Difficulté visée pour un labyrinthe : longueur de la solution et proportion d'impasses.
+// La longueur est exprimée en détour, rapport entre la solution et la distance de Manhattan du départ (0, 0)
+// à l'arrivée (width - 1, height - 1) : 1 pour un chemin direct, quelle que soit la taille de la grille.
+struct DifficultyTarget {
+    double minDetour, maxDetour;              // Bornes du détour de la solution
+    double minDeadEndRatio, maxDeadEndRatio;  // Bornes de la proportion d'impasses parmi les cellules
+
+    // Aucune contrainte : le labyrinthe généré est gardé tel quel
+    static DifficultyTarget Any() { return DifficultyTarget{0.0, 1e9, 0.0, 1.0}; }
+    bool IsAny() const { return minDetour <= 1.0 && maxDetour >= 1e9 && minDeadEndRatio <= 0.0 && maxDeadEndRatio >= 1.0; }
+};
+
+// Résultat d'une mise au point
+struct DifficultyReport {
+    bool reached;          // Vrai si le labyrinthe respecte la cible
+    int moves;             // Nombre de murs déplacés
+    int solutionLength;    // Longueur finale de la solution (en déplacements)
+    double deadEndRatio;   // Proportion finale d'impasses
+    float ms;              // Durée de la mise au point (en millisecondes)
+};
+
+// Mise au point d'un labyrinthe parfait vers une difficulté visée, par réparations locales plutôt que
+// par des générations complètes jusqu'à tomber par hasard sur un labyrinthe qui convient.
+//
+// Une réparation ouvre un mur (a, b), ce qui crée une seule boucle, puis referme un autre passage de cette boucle :
+// le labyrinthe reste parfait. Si le passage refermé est sur la solution, celle-ci fait le tour par l'autre côté
+// de la boucle et sa longueur devient L - |ia - ib| + da + db + 1, où ia est l'indice sur la solution de la cellule
+// où se rattache la branche de a et da la profondeur de a dans cette branche. Chaque réparation est choisie
+// parmi tous les murs pour amener la longueur dans la cible en un coup quand c'est possible ; les impasses
+// sont ensuite corrigées par des boucles qui ne touchent pas à la solution.
+//
+// Chaque réparation refait une analyse de la grille (parcours en largeur, proportionnel au nombre de cellules) :
+// sur la grille du jeu, une mise au point complète prend une fraction de milliseconde. La durée est bornée
+// par un budget exprimé en cellules analysées plutôt qu'en millisecondes : le résultat ne dépend pas de la charge
+// de la machine, et le même identifiant redonne le même labyrinthe. Si le budget est épuisé, le labyrinthe
+// rendu est le dernier obtenu, toujours parfait.
+class DifficultyTuner {
+public:
+    static const long DEFAULT_BUDGET_CELLS = 1 << 16;  // Budget par défaut, de l'ordre de 2 ms : compatible avec une image à 60 FPS
+    static const int MAX_MOVES = 256;                  // Nombre maximal de réparations
+
+private:
+    static const int SAMPLES = 32;        // Murs essayés par réparation des impasses
+    static const int MAX_FAILURES = 8;    // Réparations infructueuses consécutives avant d'abandonner
+
+    int width, height;
+    std::vector<int> parent;      // Cellule précédente vers le départ (arbre du labyrinthe enraciné en (0, 0))
+    std::vector<int> order;       // Cellules dans l'ordre du parcours en largeur depuis le départ
+    std::vector<int> attach;      // Indice sur la solution de la cellule où se rattache la branche de chaque cellule
+    std::vector<int> branch;      // Profondeur de chaque cellule dans sa branche (0 sur la solution)
+    std::vector<uint8_t> exits;   // Nombre d'ouvertures de chaque cellule
+    std::vector<int> path;        // Solution, du départ à l'arrivée
+    std::vector<int> cycle;       // Cellules de la boucle étudiée, de a à b
+    std::vector<int> climb;       // Cellules remontées depuis b (TraceCycle)
+    int deadEnds;                 // Nombre d'impasses
+    long work;                    // Cellules analysées depuis le début de la mise au point (décompte du budget)
+
+    static int StepX(int d) { return d == MazeGrid::RIGHT ? 1 : (d == MazeGrid::LEFT ? -1 : 0); }
+    static int StepY(int d) { return d == MazeGrid::DOWN ? 1 : (d == MazeGrid::UP ? -1 : 0); }
+
+    // Direction de la cellule a vers sa voisine b
+    int DirectionTo(int a, int b) const {
+        if (b == a + 1) return MazeGrid::RIGHT;
+        if (b == a - 1) return MazeGrid::LEFT;
+        return b > a ? MazeGrid::DOWN : MazeGrid::UP;
+    }
+
+    // Parcours en largeur depuis le départ : arbre, solution, branches, ouvertures et impasses
+    void Analyze(const MazeGrid& grid) {
+        size_t count = (size_t)width * height;
+        parent.assign(count, -1);
+        exits.assign(count, 0);
+        order.clear();
+        order.reserve(count);
+        deadEnds = 0;
+        work += (long)count;
+        parent[0] = 0;
+        order.push_back(0);
+        for (size_t head = 0; head < order.size(); head++) {
+            int cell = order[head];
+            int x = cell % width, y = cell / width;
+            for (int d = 0; d < 4; d++) {
+                int nx = x + StepX(d), ny = y + StepY(d);
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height || grid.HasWall(x, y, StepX(d), StepY(d))) continue;
+                exits[cell]++;
+                int next = ny * width + nx;
+                if (parent[next] < 0) {
+                    parent[next] = cell;
+                    order.push_back(next);
+                }
+            }
+            if (exits[cell] == 1) deadEnds++;
+        }
+
+        path.clear();
+        for (int cell = (int)count - 1; cell != 0; cell = parent[cell]) path.push_back(cell);
+        path.push_back(0);
+        std::reverse(path.begin(), path.end());
+
+        attach.assign(count, -1);
+        branch.assign(count, 0);
+        for (size_t i = 0; i < path.size(); i++) attach[path[i]] = (int)i;
+        for (int cell : order) {
+            if (attach[cell] >= 0) continue;
+            attach[cell] = attach[parent[cell]];  // Le parent précède toujours la cellule dans l'ordre du parcours
+            branch[cell] = branch[parent[cell]] + 1;
+        }
+    }
+
+    int SolutionLength() const { return (int)path.size() - 1; }
+    int Depth(int cell) const { return attach[cell] + branch[cell]; }  // Distance au départ dans l'arbre
+
+    // Nombre d'impasses après avoir ouvert (a, b) et refermé (c, d)
+    int DeadEndsAfter(int a, int b, int c, int d) const {
+        int cells[4] = {a, b, c, d};
+        int change[4] = {1, 1, -1, -1};
+        int result = deadEnds;
+        for (int i = 0; i < 4; i++) {
+            bool seen = false;
+            int total = 0;
+            for (int j = 0; j < 4; j++) {
+                if (cells[j] != cells[i]) continue;
+                if (j < i) seen = true;
+                total += change[j];
+            }
+            if (seen) continue;  // Cellule déjà comptée (a peut être c ou d)
+            int before = exits[cells[i]], after = before + total;
+            result += (after == 1) - (before == 1);
+        }
+        return result;
+    }
+
+    // Écart entre une valeur et l'intervalle [low, high] (0 dedans)
+    static double Distance(double value, double low, double high) {
+        return value < low ? low - value : (value > high ? value - high : 0.0);
+    }
+
+    // Réparation de la longueur : parmi tous les murs entre deux branches rattachées en des points différents,
+    // choisit celui qui amène la longueur dans [low, high] (au hasard parmi les candidats), sinon le plus proche
+    bool RepairLength(MazeGrid& grid, Rng& random, int low, int high, int deadLow, int deadHigh) {
+        int length = SolutionLength();
+        double current = Distance(length, low, high);
+        int bestA = -1, bestB = -1;
+        double bestDistance = current;
+        int inRange = 0;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int a = y * width + x;
+                for (int down = 0; down < 2; down++) {
+                    if (down ? (y + 1 >= height || !grid.HasHorizontalWall(x, y + 1)) : (x + 1 >= width || !grid.HasVerticalWall(x + 1, y))) continue;
+                    int b = down ? a + width : a + 1;
+                    if (attach[a] == attach[b]) continue;  // Boucle hors de la solution : la longueur ne change pas
+                    int newLength = length - abs(attach[a] - attach[b]) + branch[a] + branch[b] + 1;
+                    double distance = Distance(newLength, low, high);
+                    if (distance == 0.0) {
+                        // Tirage uniforme parmi les murs qui atteignent la cible (échantillonnage par réservoir)
+                        if (random.Range(0, inRange++) == 0) {
+                            bestA = a; bestB = b;
+                        }
+                        bestDistance = 0.0;
+                    } else if (inRange == 0 && distance < bestDistance) {
+                        bestA = a; bestB = b; bestDistance = distance;
+                    }
+                }
+            }
+        }
+        if (bestA < 0) return false;
+
+        // Passage de la solution à refermer entre les deux points de rattachement :
+        // celui qui laisse le nombre d'impasses le plus près de sa cible
+        int first = std::min(attach[bestA], attach[bestB]), last = std::max(attach[bestA], attach[bestB]);
+        int bestK = -1;
+        double bestDead = 0;
+        work += (long)width * height + (last - first);  // Parcours de tous les murs, puis du segment de la solution
+        for (int k = first; k < last; k++) {
+            double dead = Distance(DeadEndsAfter(bestA, bestB, path[k], path[k + 1]), deadLow, deadHigh);
+            if (bestK < 0 || dead < bestDead || (dead == bestDead && random.Range(0, 1) == 0)) {
+                bestK = k;
+                bestDead = dead;
+            }
+        }
+        grid.RemoveWall(bestA % width, bestA / width, DirectionTo(bestA, bestB));
+        grid.AddWall(path[bestK] % width, path[bestK] / width, DirectionTo(path[bestK], path[bestK + 1]));
+        return true;
+    }
+
+    // Boucle créée par l'ouverture du mur (a, b) : chemin de a à b dans l'arbre, par leur ancêtre commun
+    void TraceCycle(int a, int b) {
+        cycle.clear();
+        climb.clear();
+        while (a != b) {
+            if (Depth(a) >= Depth(b)) {
+                cycle.push_back(a);
+                a = parent[a];
+            } else {
+                climb.push_back(b);
+                b = parent[b];
+            }
+        }
+        cycle.push_back(a);
+        cycle.insert(cycle.end(), climb.rbegin(), climb.rend());
+        work += (long)cycle.size();
+    }
+
+    // Réparation des impasses : essaie quelques murs et referme, sur la boucle créée, le passage qui rapproche le plus
+    // le nombre d'impasses de [deadLow, deadHigh] sans faire sortir la longueur de [low, high]
+    bool RepairDeadEnds(MazeGrid& grid, Rng& random, int low, int high, int deadLow, int deadHigh) {
+        int length = SolutionLength();
+        bool fewer = deadEnds > deadHigh;
+        double current = Distance(deadEnds, deadLow, deadHigh);
+        int bestA = -1, bestB = -1, bestC = -1, bestD = -1;
+        double bestDistance = current;
+
+        for (int sample = 0; sample < SAMPLES; sample++) {
+            // Moins d'impasses : le mur ouvert part d'une impasse ; plus d'impasses : d'une cellule quelconque
+            int a = random.Range(0, width * height - 1);
+            if (fewer && exits[a] != 1) continue;
+            int direction = random.Range(0, 3);
+            int x = a % width + StepX(direction), y = a / width + StepY(direction);
+            if (x < 0 || x >= width || y < 0 || y >= height || !grid.HasWall(a % width, a / width, StepX(direction), StepY(direction))) continue;
+            int b = y * width + x;
+
+            // Longueur de la solution si le passage refermé est sur la solution
+            int rerouted = length - abs(attach[a] - attach[b]) + branch[a] + branch[b] + 1;
+            TraceCycle(a, b);
+            for (size_t i = 0; i + 1 < cycle.size(); i++) {
+                int c = cycle[i], d = cycle[i + 1];
+                bool onSolution = branch[c] == 0 && branch[d] == 0;
+                if (onSolution && Distance(rerouted, low, high) > 0) continue;
+                double distance = Distance(DeadEndsAfter(a, b, c, d), deadLow, deadHigh);
+                if (distance < bestDistance) {
+                    bestA = a; bestB = b; bestC = c; bestD = d; bestDistance = distance;
+                }
+            }
+        }
+        if (bestA < 0) return false;
+        grid.RemoveWall(bestA % width, bestA / width, DirectionTo(bestA, bestB));
+        grid.AddWall(bestC % width, bestC / width, DirectionTo(bestC, bestD));
+        return true;
+    }
+
+public:
+    DifficultyTuner() : width(0), height(0), deadEnds(0), work(0) {}
+
+    // Modifie le labyrinthe parfait grid jusqu'à ce qu'il respecte target, en au plus MAX_MOVES réparations
+    // et budgetCells cellules analysées (une analyse au moins). Avec la même grille, la même cible, la même suite
+    // random et le même budget, le résultat est toujours le même.
+    DifficultyReport Tune(MazeGrid& grid, const DifficultyTarget& target, Rng& random, long budgetCells = DEFAULT_BUDGET_CELLS) {
+        auto start = std::chrono::steady_clock::now();
+        width = grid.GetWidth();
+        height = grid.GetHeight();
+        double cells = (double)width * height;
+        int manhattan = width + height - 2;
+        int low = (int)std::ceil(target.minDetour * manhattan), high = (int)std::min(std::floor(target.maxDetour * manhattan), cells - 1);
+        int deadLow = (int)std::ceil(target.minDeadEndRatio * cells), deadHigh = (int)std::floor(target.maxDeadEndRatio * cells);
+
+        DifficultyReport report = {false, 0, 0, 0.0, 0.0f};
+        int failures = 0;
+        work = 0;
+        while (true) {
+            Analyze(grid);
+            bool lengthOk = SolutionLength() >= low && SolutionLength() <= high;
+            bool deadEndsOk = deadEnds >= deadLow && deadEnds <= deadHigh;
+            report.reached = lengthOk && deadEndsOk;
+            // Arrêt avant une réparation et une analyse qui dépasseraient le budget
+            if (report.reached || report.moves >= MAX_MOVES || failures >= MAX_FAILURES || work + 2 * (long)cells > budgetCells) break;
+
+            bool repaired = !lengthOk ? RepairLength(grid, random, low, high, deadLow, deadHigh)
+                                      : RepairDeadEnds(grid, random, low, high, deadLow, deadHigh);
+            if (repaired) {
+                report.moves++;
+                failures = 0;
+            } else {
+                failures++;
+            }
+        }
+        report.solutionLength = SolutionLength();
+        report.deadEndRatio = deadEnds / cells;
+        report.ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return report;
+    }
+};
+
+#endif
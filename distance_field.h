@@ -0,0 +1,197 @@
+#ifndef DISTANCE_FIELD_H
+#define DISTANCE_FIELD_H
+
+#include <assert.h>
+#include <stdint.h>
+#include <algorithm>
+#include <vector>
+#include "maze_grid.h"
+
+// Champ de distances vers l'arrivée, calculé une fois par labyrinthe par un parcours en largeur.
+//
+// Pour chaque cellule : le nombre de déplacements restant jusqu'à l'arrivée (32 bits) et la direction
+// du premier déplacement vers l'arrivée (2 bits, quatre cellules par octet). Le prochain pas et la distance
+// restante s'obtiennent alors en temps constant, sans recherche, pour l'aide au joueur, les obstacles
+// qui poursuivent le joueur ou l'évaluation de la difficulté.
+class DistanceField {
+public:
+    static const uint32_t UNREACHABLE = 0xFFFFFFFFu;  // Distance d'une cellule sans chemin vers l'arrivée
+    // Nombre maximal de cellules : UpdateRegion code l'indice d'une cellule sur 30 bits (cellule << 2 | direction)
+    static const size_t MAX_CELLS = (size_t)1 << 30;
+
+private:
+    int width, height;               // Dimensions du labyrinthe (en cellules)
+    int goalX, goalY;                // Arrivée
+    std::vector<uint32_t> distance;  // Distance de chaque cellule à l'arrivée
+    std::vector<uint8_t> direction;  // Direction du prochain pas (MazeGrid::Direction), 2 bits par cellule
+    std::vector<int> queue;          // File du parcours en largeur, conservée pour éviter les réallocations
+    std::vector<uint64_t> sources;   // Points de départ d'une mise à jour locale (UpdateRegion)
+
+    void SetDirection(size_t cell, int value) {
+        int shift = (int)(cell & 3) * 2;
+        direction[cell >> 2] = (uint8_t)((direction[cell >> 2] & ~(3 << shift)) | (value << shift));
+    }
+
+public:
+    DistanceField() : width(0), height(0), goalX(0), goalY(0) {}
+
+    // Calcule les distances de toutes les cellules à l'arrivée (goalX, goalY), pour une grille d'au plus MAX_CELLS cellules
+    void Build(const MazeGrid& grid, int newGoalX, int newGoalY) {
+        width = grid.GetWidth();
+        height = grid.GetHeight();
+        goalX = newGoalX;
+        goalY = newGoalY;
+        size_t count = (size_t)width * height;
+        assert(count <= MAX_CELLS);
+        distance.assign(count, (uint32_t)UNREACHABLE);  // Copie de la constante : assign la prend par référence
+        direction.assign((count + 3) / 4, 0);
+        queue.clear();
+        queue.reserve(count);
+        if (count == 0) return;
+
+        int goal = goalY * width + goalX;
+        distance[goal] = 0;
+        queue.push_back(goal);
+        for (size_t head = 0; head < queue.size(); head++) {
+            int cell = queue[head];
+            int x = cell % width, y = cell / width;
+            uint32_t next = distance[cell] + 1;
+
+            // Chaque voisine atteinte depuis cette cellule doit s'y rendre pour rejoindre l'arrivée :
+            // sa direction est donc l'opposée de celle du parcours
+            if (y > 0 && !grid.HasHorizontalWall(x, y) && distance[cell - width] == UNREACHABLE) {
+                distance[cell - width] = next;
+                SetDirection(cell - width, MazeGrid::DOWN);
+                queue.push_back(cell - width);
+            }
+            if (x + 1 < width && !grid.HasVerticalWall(x + 1, y) && distance[cell + 1] == UNREACHABLE) {
+                distance[cell + 1] = next;
+                SetDirection(cell + 1, MazeGrid::LEFT);
+                queue.push_back(cell + 1);
+            }
+            if (y + 1 < height && !grid.HasHorizontalWall(x, y + 1) && distance[cell + width] == UNREACHABLE) {
+                distance[cell + width] = next;
+                SetDirection(cell + width, MazeGrid::UP);
+                queue.push_back(cell + width);
+            }
+            if (x > 0 && !grid.HasVerticalWall(x, y) && distance[cell - 1] == UNREACHABLE) {
+                distance[cell - 1] = next;
+                SetDirection(cell - 1, MazeGrid::RIGHT);
+                queue.push_back(cell - 1);
+            }
+        }
+    }
+
+    // Recalcule les distances des seules cellules de la fenêtre [x0, x1) x [y0, y1), après une re-génération locale
+    // qui a conservé les chemins entre les ouvertures de la fenêtre (MazeGenerator::RegenerateRegion) :
+    // les distances hors de la fenêtre n'ont pas changé et servent de points de départ.
+    void UpdateRegion(const MazeGrid& grid, int x0, int y0, int x1, int y1) {
+        assert((size_t)width * height <= MAX_CELLS);
+        for (int y = y0; y < y1; y++) {
+            std::fill(distance.begin() + (size_t)y * width + x0, distance.begin() + (size_t)y * width + x1, (uint32_t)UNREACHABLE);
+        }
+
+        // Départs : l'arrivée, et chaque cellule du bord reliée à une voisine extérieure (distance de la voisine + 1),
+        // codés distance << 32 | cellule << 2 | direction vers la voisine. Une voisine sans chemin vers l'arrivée
+        // n'est pas un départ (sa distance + 1 reviendrait à 0).
+        sources.clear();
+        auto addSource = [this](uint64_t cell, size_t neighbour, int toNeighbour) {
+            if (distance[neighbour] == UNREACHABLE) return;
+            sources.push_back((uint64_t)(distance[neighbour] + 1) << 32 | cell << 2 | (uint64_t)toNeighbour);
+        };
+        if (goalX >= x0 && goalX < x1 && goalY >= y0 && goalY < y1) {
+            sources.push_back((uint64_t)(goalY * width + goalX) << 2);
+        }
+        for (int y = y0; y < y1; y++) {
+            for (int x = x0; x < x1; x++) {
+                if (x != x0 && x != x1 - 1 && y != y0 && y != y1 - 1) continue;  // Seulement le bord de la fenêtre
+                uint64_t cell = (uint64_t)y * width + x;
+                if (x == x0 && x > 0 && !grid.HasVerticalWall(x, y)) {
+                    addSource(cell, cell - 1, MazeGrid::LEFT);
+                }
+                if (x == x1 - 1 && x + 1 < width && !grid.HasVerticalWall(x + 1, y)) {
+                    addSource(cell, cell + 1, MazeGrid::RIGHT);
+                }
+                if (y == y0 && y > 0 && !grid.HasHorizontalWall(x, y)) {
+                    addSource(cell, cell - width, MazeGrid::UP);
+                }
+                if (y == y1 - 1 && y + 1 < height && !grid.HasHorizontalWall(x, y + 1)) {
+                    addSource(cell, cell + width, MazeGrid::DOWN);
+                }
+            }
+        }
+        std::sort(sources.begin(), sources.end());
+
+        // Parcours en largeur à départs multiples : les départs triés sont fusionnés avec la file,
+        // dont les distances sont elles aussi croissantes ; chaque cellule reçoit la plus petite distance
+        queue.clear();
+        size_t next = 0;
+        size_t head = 0;
+        while (true) {
+            if (next < sources.size() && (head == queue.size() || (uint32_t)(sources[next] >> 32) <= distance[queue[head]])) {
+                uint64_t source = sources[next++];
+                int cell = (int)((source & 0xFFFFFFFFu) >> 2);
+                if (distance[cell] != UNREACHABLE) continue;  // Déjà atteinte par un chemin au moins aussi court
+                distance[cell] = (uint32_t)(source >> 32);
+                SetDirection(cell, (int)(source & 3));
+                queue.push_back(cell);
+                continue;
+            }
+            if (head == queue.size()) break;
+
+            int cell = queue[head++];
+            int x = cell % width, y = cell / width;
+            uint32_t step = distance[cell] + 1;
+            if (y > y0 && !grid.HasHorizontalWall(x, y) && distance[cell - width] == UNREACHABLE) {
+                distance[cell - width] = step;
+                SetDirection(cell - width, MazeGrid::DOWN);
+                queue.push_back(cell - width);
+            }
+            if (x + 1 < x1 && !grid.HasVerticalWall(x + 1, y) && distance[cell + 1] == UNREACHABLE) {
+                distance[cell + 1] = step;
+                SetDirection(cell + 1, MazeGrid::LEFT);
+                queue.push_back(cell + 1);
+            }
+            if (y + 1 < y1 && !grid.HasHorizontalWall(x, y + 1) && distance[cell + width] == UNREACHABLE) {
+                distance[cell + width] = step;
+                SetDirection(cell + width, MazeGrid::UP);
+                queue.push_back(cell + width);
+            }
+            if (x > x0 && !grid.HasVerticalWall(x, y) && distance[cell - 1] == UNREACHABLE) {
+                distance[cell - 1] = step;
+                SetDirection(cell - 1, MazeGrid::RIGHT);
+                queue.push_back(cell - 1);
+            }
+        }
+    }
+
+    // Nombre de déplacements de (x, y) jusqu'à l'arrivée, UNREACHABLE s'il n'y a pas de chemin
+    uint32_t GetDistance(int x, int y) const {
+        return distance[(size_t)y * width + x];
+    }
+
+    // Premier déplacement (dx, dy) de (x, y) vers l'arrivée ; false sur l'arrivée ou sans chemin
+    bool NextStep(int x, int y, int& dx, int& dy) const {
+        size_t cell = (size_t)y * width + x;
+        dx = dy = 0;
+        if (distance[cell] == 0 || distance[cell] == UNREACHABLE) return false;
+        switch ((direction[cell >> 2] >> ((cell & 3) * 2)) & 3) {
+            case MazeGrid::UP: dy = -1; break;
+            case MazeGrid::RIGHT: dx = 1; break;
+            case MazeGrid::DOWN: dy = 1; break;
+            case MazeGrid::LEFT: dx = -1; break;
+        }
+        return true;
+    }
+
+    int GetGoalX() const { return goalX; }
+    int GetGoalY() const { return goalY; }
+
+    // Mémoire occupée par le champ (en octets), file du parcours comprise
+    size_t MemoryBytes() const {
+        return distance.capacity() * sizeof(uint32_t) + direction.capacity() + queue.capacity() * sizeof(int) +
+               sources.capacity() * sizeof(uint64_t);
+    }
+};
+
+#endif
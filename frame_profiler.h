@@ -0,0 +1,116 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+// Mesure de la durée de chaque phase d'une image (entrées, simulation, dessin du labyrinthe,
+// dessin de l'interface, présentation), conservée dans un tampon circulaire des dernières images.
+// Indépendant de raylib : le jeu l'affiche en surimpression et l'exporte en CSV.
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+class FrameProfiler {
+public:
+    // Phases d'une image, dans l'ordre où elles se déroulent
+    enum Phase { INPUT, SIMULATE, MAZE_DRAW, HUD_DRAW, PRESENT, PHASE_COUNT };
+
+    // Nombre d'images conservées (10 secondes à 60 images par seconde)
+    static const int CAPACITY = 600;
+
+    // Nom d'une phase, utilisé pour l'affichage et l'en-tête du CSV
+    static const char* PhaseName(int phase) {
+        static const char* const names[PHASE_COUNT] = {"input", "simulate", "maze_draw", "hud_draw", "present"};
+        return names[phase];
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    // Durées d'une image (en millisecondes)
+    struct FrameTimes {
+        float phaseMs[PHASE_COUNT];
+        float totalMs;
+    };
+
+    std::vector<FrameTimes> frames;  // Tampon circulaire des dernières images
+    int next;                        // Indice où sera écrite la prochaine image
+    int count;                       // Nombre d'images valides dans le tampon
+    long long frameIndex;            // Numéro de l'image en cours depuis le début
+    FrameTimes current;              // Image en cours de mesure
+    Clock::time_point frameStart;    // Début de l'image en cours
+    Clock::time_point phaseStart;    // Fin de la phase précédente
+    mutable std::vector<float> scratch; // Copie triée partiellement par Percentile (évite une allocation par appel)
+
+    static float ElapsedMs(Clock::time_point from, Clock::time_point to) {
+        return std::chrono::duration<float, std::milli>(to - from).count();
+    }
+
+    // Durée de l'image numéro i, la plus ancienne ayant l'indice 0
+    const FrameTimes& At(int i) const {
+        return frames[(next - count + i + CAPACITY) % CAPACITY];
+    }
+
+public:
+    FrameProfiler() : frames(CAPACITY), next(0), count(0), frameIndex(0), current() {}
+
+    // Début d'une nouvelle image
+    void BeginFrame() {
+        current = FrameTimes();
+        frameStart = phaseStart = Clock::now();
+    }
+
+    // Fin de la phase donnée : le temps écoulé depuis la phase précédente lui est attribué
+    void Mark(Phase phase) {
+        Clock::time_point now = Clock::now();
+        current.phaseMs[phase] += ElapsedMs(phaseStart, now);
+        phaseStart = now;
+    }
+
+    // Fin de l'image : ses durées sont ajoutées au tampon circulaire
+    void EndFrame() {
+        current.totalMs = ElapsedMs(frameStart, Clock::now());
+        frames[next] = current;
+        next = (next + 1) % CAPACITY;
+        if (count < CAPACITY) count++;
+        frameIndex++;
+    }
+
+    // Centile p (entre 0 et 1) de la durée d'une phase sur les images conservées,
+    // ou de la durée totale de l'image si phase vaut PHASE_COUNT
+    float Percentile(int phase, float p) const {
+        if (count == 0) return 0.0f;
+        scratch.resize(count);
+        for (int i = 0; i < count; i++) {
+            scratch[i] = phase == PHASE_COUNT ? At(i).totalMs : At(i).phaseMs[phase];
+        }
+        int rank = std::min(count - 1, (int)(p * count));
+        std::nth_element(scratch.begin(), scratch.begin() + rank, scratch.end());
+        return scratch[rank];
+    }
+
+    // Écrit les images conservées, de la plus ancienne à la plus récente, dans un fichier CSV.
+    // Retourne false si le fichier n'a pas pu être ouvert.
+    bool ExportCsv(const char* path) const {
+        FILE* file = fopen(path, "w");
+        if (!file) return false;
+
+        fprintf(file, "frame");
+        for (int phase = 0; phase < PHASE_COUNT; phase++) fprintf(file, ",%s_ms", PhaseName(phase));
+        fprintf(file, ",total_ms\n");
+
+        for (int i = 0; i < count; i++) {
+            const FrameTimes& frame = At(i);
+            fprintf(file, "%lld", frameIndex - count + i);
+            for (int phase = 0; phase < PHASE_COUNT; phase++) fprintf(file, ",%.4f", frame.phaseMs[phase]);
+            fprintf(file, ",%.4f\n", frame.totalMs);
+        }
+        fclose(file);
+        return true;
+    }
+
+    // Nombre d'images actuellement conservées
+    int GetCount() const { return count; }
+};
+
+#endif
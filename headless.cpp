@@ -0,0 +1,121 @@
+// Simulation sans fenêtre ni carte graphique : fait jouer un joueur aléatoire pendant
+// un grand nombre de pas et mesure le débit de Simulation::Step.
+// Compilé sans raylib : make headless && ./headless [pas] [niveau 0-3] [LARGEURxHAUTEUR] [graine]
+// Le niveau 3 est le mode sans fin : le joueur s'éloigne du départ et la mémoire doit rester bornée.
+// Avec la même graine, deux exécutions jouent exactement la même partie.
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <unordered_set>
+#include <vector>
+#include "simulation.h"
+
+using namespace std;
+
+// Niveau passé en argument pour le mode sans fin
+static const int ENDLESS_LEVEL = 3;
+
+// Mode sans fin : un explorateur en profondeur, qui essaie d'abord la droite puis le bas,
+// s'éloigne du départ et traverse des milliers de blocs
+static int RunEndless(long long steps, unsigned long long seed, float dt) {
+    EndlessSimulation sim(seed);
+    size_t startBytes = sim.maze.MemoryBytes();
+    const int dx[4] = {1, 0, 0, -1};  // Droite, bas, haut, gauche
+    const int dy[4] = {0, 1, -1, 0};
+    vector<int> path;               // Directions prises depuis le départ (pour revenir en arrière)
+    unordered_set<uint64_t> seen;   // Cases déjà explorées (mémoire de l'explorateur, pas du labyrinthe)
+    seen.insert(0);
+
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < steps; i++) {
+        int x = sim.player.x, y = sim.player.y;
+        int move = -1;
+        for (int d = 0; d < 4 && move < 0; d++) {
+            uint64_t key = ((uint64_t)(uint32_t)(x + dx[d]) << 32) | (uint32_t)(y + dy[d]);
+            if (!sim.maze.HasWall(x, y, dx[d], dy[d]) && seen.insert(key).second) move = d;
+        }
+        if (move >= 0) {
+            path.push_back(move);
+        } else if (!path.empty()) {
+            move = 3 - path.back();  // Impasse : direction opposée à la dernière avancée
+            path.pop_back();
+        }
+
+        SimInput input;
+        input.right = move >= 0 && dx[move] == 1;
+        input.left = move >= 0 && dx[move] == -1;
+        input.down = move >= 0 && dy[move] == 1;
+        input.up = move >= 0 && dy[move] == -1;
+        sim.Step(dt, input);
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("mode sans fin, graine %llx\n", seed);
+    printf("%lld pas en %.3f s : %.0f pas/s\n", steps, elapsed, steps / elapsed);
+    printf("position finale (%d, %d), distance maximale %d cellules\n", sim.player.x, sim.player.y, sim.farthest);
+    printf("%lld blocs générés, %d/%d en mémoire, %zu octets (%zu au départ)\n",
+           sim.maze.GetGeneratedCount(), sim.maze.GetLoadedCount(), sim.maze.GetCapacity(),
+           sim.maze.MemoryBytes(), startBytes);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    long long steps = 1000000;            // Nombre de pas simulés
+    int level = Niveau::MOYEN;            // Niveau de difficulté
+    int gridWidth = 20, gridHeight = 15;  // Taille du labyrinthe du jeu
+    unsigned long long seed = 1234;       // Graine fixe pour que deux exécutions soient comparables
+    const float dt = 1.0f / 60.0f;        // Pas de temps simulé (une image à 60 FPS)
+
+    if (argc > 1) steps = atoll(argv[1]);
+    if (argc > 2) level = atoi(argv[2]);
+    if (argc > 3) sscanf(argv[3], "%dx%d", &gridWidth, &gridHeight);
+    if (argc > 4) seed = strtoull(argv[4], NULL, 0);
+    if (steps < 1 || level < Niveau::FACILE || level > ENDLESS_LEVEL || gridWidth < 1 || gridHeight < 1) {
+        fprintf(stderr, "usage: %s [pas] [niveau 0-3] [LARGEURxHAUTEUR] [graine]\n", argv[0]);
+        return 1;
+    }
+    if (level == ENDLESS_LEVEL) return RunEndless(steps, seed, dt);
+
+    Simulation sim((Niveau::Level)level, gridWidth, gridHeight, seed);
+    sim.asyncRegeneration = false;  // Le temps simulé avance bien plus vite que le temps réel
+    sim.Initialize();
+    Rng bot(seed + 2);  // Les commandes du joueur aléatoire sont elles aussi reproductibles
+
+    char firstId[96];
+    sim.maze.GetId().Format(firstId, sizeof(firstId));
+    unsigned long long firstChecksum = sim.maze.GetGrid().Checksum();
+    unsigned firstSolution = sim.maze.GetDistanceField().GetDistance(0, 0);
+    DifficultyReport firstTuning = sim.maze.GetLastTuning();
+
+    long long wins = 0;
+    long long regenerations = 0;
+    auto start = chrono::steady_clock::now();
+    for (long long i = 0; i < steps; i++) {
+        // Le joueur aléatoire appuie sur une seule direction par pas
+        SimInput input;
+        switch (bot.Range(0, 3)) {
+            case 0: input.right = true; break;
+            case 1: input.left = true; break;
+            case 2: input.up = true; break;
+            case 3: input.down = true; break;
+        }
+        sim.Step(dt, input);
+
+        if (sim.mazeChanged) regenerations++;
+        if (sim.gameWon) {
+            wins++;
+            sim.Reset();  // Nouvelle partie dans un nouveau labyrinthe
+        }
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    printf("niveau %d, premier labyrinthe %s (empreinte %016llx, solution %u pas)\n", level, firstId, firstChecksum, firstSolution);
+    if (!sim.maze.GetDifficultyTarget().IsAny()) printf("mise au point : %s, %d murs déplacés en %.3f ms (impasses %.1f%%)\n", firstTuning.reached ? "cible atteinte" : "cible manquée",
+           firstTuning.moves, firstTuning.ms, firstTuning.deadEndRatio * 100.0);
+    printf("%lld pas en %.3f s : %.0f pas/s (%.1f h de jeu simulées)\n",
+           steps, elapsed, steps / elapsed, steps * dt / 3600.0);
+    printf("%lld victoires, %lld régénérations, position finale (%d, %d), %d obstacles (%zu octets)\n",
+           wins, regenerations, sim.player.position.x, sim.player.position.y,
+           sim.obstacles.GetCount(), sim.obstacles.MemoryBytes());
+    return 0;
+}
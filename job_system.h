@@ -0,0 +1,265 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Compteur des travaux d'un groupe : une barrière (fence) qui est franchie quand tous ses travaux sont terminés.
+// Une barrière peut être réutilisée une fois franchie.
+class JobFence {
+private:
+    std::atomic<int> remaining;  // Travaux soumis et pas encore terminés
+    friend class JobSystem;
+
+public:
+    JobFence() : remaining(0) {}
+    JobFence(const JobFence&) = delete;
+    JobFence& operator=(const JobFence&) = delete;
+
+    bool IsDone() const { return remaining.load(std::memory_order_acquire) == 0; }
+};
+
+// Activité d'un thread du pool depuis sa création
+struct JobWorkerStats {
+    long long jobs;     // Travaux exécutés
+    long long steals;   // Travaux pris dans la file d'un autre thread
+    double busyMs;      // Temps passé à exécuter des travaux (en millisecondes)
+    double utilisation; // Part du temps écoulé passée à travailler (0 à 1)
+};
+
+// Pool de threads à vol de travail, partagé par la génération des labyrinthes, le chargement des ressources
+// et les outils de simulation en masse, au lieu que chacun lance ses propres threads.
+//
+// Chaque thread a sa propre file : il y dépose les travaux qu'il soumet et les reprend par la fin (les plus récents,
+// encore en cache) ; un thread sans travail en vole au début de la file d'un autre. Les travaux soumis par un thread
+// extérieur (le thread principal) sont répartis à tour de rôle entre les files. Les files sont de simples
+// deques protégées par un verrou : les travaux durent de quelques microsecondes à quelques millisecondes,
+// le verrou n'est pas le goulot.
+//
+// Wait() fait travailler le thread qui attend : il exécute des travaux en attente au lieu de dormir, ce qui permet
+// à un travail de soumettre des sous-travaux et de les attendre sans bloquer le pool.
+class JobSystem {
+private:
+    struct Job {
+        std::function<void()> task;
+        JobFence* fence;
+    };
+
+    // File et compteurs d'un thread ; la dernière entrée compte le travail fait par les threads extérieurs dans Wait()
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Job> queue;
+        std::atomic<long long> jobs, steals, busyNs;
+        Worker() : jobs(0), steals(0), busyNs(0) {}
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;  // workerCount files, plus les compteurs des threads extérieurs
+    std::vector<std::thread> workerThreads;
+    int workerCount;
+    std::atomic<int> queued;                       // Travaux en attente dans l'ensemble des files
+    std::atomic<unsigned> nextQueue;               // File de la prochaine soumission extérieure
+    std::mutex sleepMutex;                         // Sommeil des threads sans travail et des Wait()
+    std::condition_variable wake;
+    bool stopping;
+    std::chrono::steady_clock::time_point started;
+
+    // Indice du thread courant dans ce pool (-1 hors du pool)
+    int& CurrentIndex() {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    // Prend un travail : d'abord par la fin de sa propre file, sinon au début de celle d'un autre thread
+    bool TakeJob(int self, Job& job, bool& stolen) {
+        if (self >= 0) {
+            Worker& own = *workers[self];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.queue.empty()) {
+                job = std::move(own.queue.back());
+                own.queue.pop_back();
+                queued--;
+                stolen = false;
+                return true;
+            }
+        }
+        for (int i = 1; i <= workerCount; i++) {
+            int victim = ((self < 0 ? 0 : self) + i) % workerCount;
+            Worker& other = *workers[victim];
+            std::lock_guard<std::mutex> lock(other.mutex);
+            if (!other.queue.empty()) {
+                job = std::move(other.queue.front());
+                other.queue.pop_front();
+                queued--;
+                stolen = self >= 0;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Exécute un travail, compte son temps et signale la fin de son groupe
+    void Run(Job& job, int self, bool stolen) {
+        Worker& stats = *workers[self >= 0 ? self : workerCount];
+        auto start = std::chrono::steady_clock::now();
+        job.task();
+        stats.busyNs += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        stats.jobs++;
+        if (stolen) stats.steals++;
+        if (job.fence->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(sleepMutex);  // Réveille les Wait() sur cette barrière
+            wake.notify_all();
+        }
+    }
+
+    void WorkerLoop(int index) {
+        CurrentIndex() = index;
+        while (true) {
+            Job job;
+            bool stolen;
+            if (TakeJob(index, job, stolen)) {
+                Run(job, index, stolen);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this]() { return stopping || queued > 0; });
+            if (stopping && queued == 0) return;
+        }
+    }
+
+public:
+    // threads = 0 : un thread par cœur, moins le thread principal (qui travaille aussi dans Wait())
+    explicit JobSystem(int threads = 0)
+        : queued(0), nextQueue(0), stopping(false), started(std::chrono::steady_clock::now()) {
+        if (threads <= 0) threads = (int)std::thread::hardware_concurrency() - 1;
+        workerCount = std::max(threads, 1);
+        for (int i = 0; i <= workerCount; i++) workers.emplace_back(new Worker());
+        for (int i = 0; i < workerCount; i++) workerThreads.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+
+    // Termine les travaux en attente puis arrête les threads
+    ~JobSystem() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : workerThreads) thread.join();
+    }
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Soumet un travail au groupe fence
+    void Submit(JobFence& fence, std::function<void()> task) {
+        fence.remaining.fetch_add(1, std::memory_order_relaxed);
+        int self = CurrentIndex();
+        int target = self >= 0 ? self : (int)(nextQueue++ % workerCount);
+        {
+            Worker& worker = *workers[target];
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.queue.push_back(Job{std::move(task), &fence});
+            queued++;
+        }
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        wake.notify_one();
+    }
+
+    // Attend la fin de tous les travaux du groupe fence, en exécutant des travaux en attente entre-temps
+    void Wait(JobFence& fence) {
+        int self = CurrentIndex();
+        while (!fence.IsDone()) {
+            Job job;
+            bool stolen;
+            if (TakeJob(self, job, stolen)) {
+                Run(job, self, stolen);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            wake.wait(lock, [this, &fence]() { return fence.IsDone() || queued > 0; });
+        }
+    }
+
+    // Exécute body(i) pour i de 0 à count - 1, réparti en au plus tasks travaux (0 : un par thread, thread appelant compris)
+    template <typename Body>
+    void ParallelFor(int count, Body body, int tasks = 0) {
+        if (tasks <= 0) tasks = workerCount + 1;
+        tasks = std::min(tasks, count);
+        if (tasks <= 1) {
+            for (int i = 0; i < count; i++) body(i);
+            return;
+        }
+        JobFence fence;
+        std::atomic<int> next(0);
+        for (int t = 0; t < tasks; t++) {
+            Submit(fence, [&]() {
+                for (int i = next++; i < count; i = next++) body(i);
+            });
+        }
+        Wait(fence);
+    }
+
+    int GetWorkerCount() const { return workerCount; }
+
+    // Activité du thread index du pool ; index = GetWorkerCount() pour les threads extérieurs (travail fait dans Wait())
+    JobWorkerStats GetStats(int index) const {
+        const Worker& worker = *workers[index];
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        double busyMs = worker.busyNs / 1e6;
+        return JobWorkerStats{worker.jobs, worker.steals, busyMs, elapsedMs > 0 ? busyMs / elapsedMs : 0.0};
+    }
+};
+
+// Pool partagé par tout le programme, créé à sa première utilisation
+inline JobSystem& Jobs() {
+    static JobSystem system;
+    return system;
+}
+
+// Résultat d'un travail soumis par Async(), à la manière de std::future
+template <typename T>
+class JobFuture {
+private:
+    struct State {
+        JobFence fence;
+        T value;
+    };
+    std::shared_ptr<State> state;
+
+public:
+    JobFuture() {}
+
+    // Exécute task() sur le pool partagé
+    template <typename Task>
+    static JobFuture Async(Task task) {
+        JobFuture future;
+        future.state = std::make_shared<State>();
+        std::shared_ptr<State> shared = future.state;
+        Jobs().Submit(shared->fence, [shared, task]() { shared->value = task(); });
+        return future;
+    }
+
+    // Vrai tant que le résultat n'a pas été récupéré par Get()
+    bool Valid() const { return state != nullptr; }
+    // Vrai si le travail est terminé (Get() ne bloquera pas)
+    bool IsReady() const { return state && state->fence.IsDone(); }
+
+    // Attend la fin du travail (en aidant le pool) et renvoie son résultat
+    T Get() {
+        Jobs().Wait(state->fence);
+        T value = std::move(state->value);
+        state.reset();
+        return value;
+    }
+};
+
+#endif
@@ -0,0 +1,207 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+// Tableau des scores : tous les temps de victoire, par niveau, graine et algorithme du labyrinthe.
+//
+// Le fichier n'est jamais réécrit : chaque victoire y ajoute un enregistrement de taille fixe, écrit par un travail
+// du pool partagé (job_system.h) et non par le thread du rendu. Chaque enregistrement porte une signature et
+// une empreinte : au chargement, un enregistrement incomplet (arrêt pendant une écriture) ou abîmé est sauté
+// et la lecture reprend à l'enregistrement valide suivant ; les scores déjà enregistrés ne sont jamais perdus.
+//
+// Le chargement lit le fichier en une fois sur le pool, pendant l'écran d'accueil. Au premier lancement,
+// l'ancien meilleur temps unique (best_time.txt) est repris comme un score sans niveau (level = -1).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "job_system.h"
+#include "maze_grid.h"
+
+// Victoire enregistrée
+struct Score {
+    int level;       // Niveau::Level, -1 pour un score repris de best_time.txt
+    MazeId id;       // Labyrinthe terminé
+    float seconds;   // Temps de la partie
+    int64_t date;    // Date de la victoire (secondes depuis 1970)
+};
+
+class Leaderboard {
+private:
+    static const uint32_t RECORD_MAGIC = 0x3142444C;  // "LDB1"
+
+    // Enregistrement sur disque (petit-boutiste), suivi de l'empreinte de ses autres champs
+    struct Record {
+        uint32_t magic;
+        int32_t level;
+        uint64_t seed;
+        int32_t width, height;
+        int32_t algorithm;
+        float seconds;
+        int64_t date;
+        uint32_t reserved;
+        uint32_t checksum;  // FNV-1a des octets qui précèdent
+    };
+    static_assert(sizeof(Record) == 48, "enregistrement du tableau des scores");
+
+    std::string path;            // Fichier des scores
+    std::vector<Score> scores;   // Tous les scores chargés ou ajoutés (lus seulement après la fin du chargement)
+    long skippedBytes;           // Octets abîmés sautés au chargement
+    JobFence loading;            // Chargement en cours
+    JobFence writing;            // Ajouts au fichier en cours
+    std::mutex fileMutex;        // Un seul ajout au fichier à la fois
+
+    static uint32_t Checksum(const Record& record) {
+        const unsigned char* bytes = (const unsigned char*)&record;
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < offsetof(Record, checksum); i++) hash = (hash ^ bytes[i]) * 16777619u;
+        return hash;
+    }
+
+    static Record ToRecord(const Score& score) {
+        Record record;
+        memset(&record, 0, sizeof(record));
+        record.magic = RECORD_MAGIC;
+        record.level = score.level;
+        record.seed = score.id.seed;
+        record.width = score.id.width;
+        record.height = score.id.height;
+        record.algorithm = score.id.algorithm;
+        record.seconds = score.seconds;
+        record.date = score.date;
+        record.checksum = Checksum(record);
+        return record;
+    }
+
+    // Ajoute un enregistrement à la fin du fichier (depuis un travail du pool)
+    void Append(const Record& record) {
+        std::lock_guard<std::mutex> lock(fileMutex);
+        FILE* file = fopen(path.c_str(), "ab");
+        if (!file) return;
+        fwrite(&record, sizeof(record), 1, file);
+        fclose(file);
+    }
+
+    // Lit tous les enregistrements valides ; un octet qui ne commence pas un enregistrement valide est sauté
+    void ReadFile(const std::string& legacyPath) {
+        std::vector<unsigned char> bytes;
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) {
+            ImportLegacy(legacyPath);
+            return;
+        }
+        fseek(file, 0, SEEK_END);
+        long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        if (size > 0) {
+            bytes.resize(size);
+            bytes.resize(fread(bytes.data(), 1, bytes.size(), file));
+        }
+        fclose(file);
+
+        size_t position = 0;
+        while (position + sizeof(Record) <= bytes.size()) {
+            Record record;
+            memcpy(&record, &bytes[position], sizeof(record));
+            if (record.magic != RECORD_MAGIC || record.checksum != Checksum(record) ||
+                record.algorithm < 0 || record.algorithm >= ALGORITHM_COUNT) {
+                position++;
+                skippedBytes++;
+                continue;
+            }
+            MazeId id = {record.seed, record.width, record.height, (MazeAlgorithm)record.algorithm};
+            scores.push_back(Score{record.level, id, record.seconds, record.date});
+            position += sizeof(Record);
+        }
+        skippedBytes += (long)(bytes.size() - position);
+    }
+
+    // Premier lancement : reprend le meilleur temps de l'ancien fichier texte et l'écrit dans le nouveau fichier
+    void ImportLegacy(const std::string& legacyPath) {
+        FILE* legacy = fopen(legacyPath.c_str(), "r");
+        if (!legacy) return;
+        float seconds = -1;
+        bool read = fscanf(legacy, "%f", &seconds) == 1;
+        fclose(legacy);
+        if (!read || seconds <= 0) return;
+        Score score = {-1, MazeId{0, 0, 0, BACKTRACKER}, seconds, (int64_t)time(nullptr)};
+        scores.push_back(score);
+        Append(ToRecord(score));
+    }
+
+public:
+    Leaderboard() : skippedBytes(0) {}
+
+    // Lance la lecture du fichier des scores sur le pool ; les accesseurs attendent sa fin
+    void Load(const char* file, const char* legacyFile = "best_time.txt") {
+        Jobs().Wait(loading);
+        Jobs().Wait(writing);
+        path = file;
+        scores.clear();
+        skippedBytes = 0;
+        std::string legacyPath = legacyFile;
+        Jobs().Submit(loading, [this, legacyPath]() { ReadFile(legacyPath); });
+    }
+
+    // Enregistre une victoire : visible tout de suite, écrite dans le fichier par un travail du pool
+    void Add(int level, const MazeId& id, float seconds) {
+        Jobs().Wait(loading);
+        Score score = {level, id, seconds, (int64_t)time(nullptr)};
+        scores.push_back(score);
+        Record record = ToRecord(score);
+        Jobs().Submit(writing, [this, record]() { Append(record); });
+    }
+
+    // Meilleur temps du niveau (-1 si aucun)
+    float GetBestTime(int level) {
+        Jobs().Wait(loading);
+        float best = -1;
+        for (const Score& score : scores) {
+            if (score.level == level && (best < 0 || score.seconds < best)) best = score.seconds;
+        }
+        return best;
+    }
+
+    // Meilleur temps du niveau sur le labyrinthe id (-1 si aucun)
+    float GetBestTime(int level, const MazeId& id) {
+        Jobs().Wait(loading);
+        float best = -1;
+        for (const Score& score : scores) {
+            if (score.level == level && score.id.seed == id.seed && score.id.width == id.width &&
+                score.id.height == id.height && score.id.algorithm == id.algorithm && (best < 0 || score.seconds < best)) {
+                best = score.seconds;
+            }
+        }
+        return best;
+    }
+
+    // Tous les scores, dans l'ordre où ils ont été enregistrés
+    const std::vector<Score>& GetScores() {
+        Jobs().Wait(loading);
+        return scores;
+    }
+
+    // Octets abîmés sautés au dernier chargement (0 pour un fichier sain)
+    long GetSkippedBytes() {
+        Jobs().Wait(loading);
+        return skippedBytes;
+    }
+
+    // Attend la fin des écritures en cours ; à appeler avant de quitter
+    void Flush() {
+        Jobs().Wait(loading);
+        Jobs().Wait(writing);
+    }
+};
+
+// Tableau des scores partagé par tout le jeu
+inline Leaderboard& Scores() {
+    static Leaderboard leaderboard;
+    return leaderboard;
+}
+
+#endif
@@ -0,0 +1,124 @@
+// Vérification du tableau des scores (leaderboard.h) sans fenêtre : reprise de best_time.txt, ajouts,
+// puis relecture d'un fichier abîmé comme après un arrêt brutal.
+//
+// Le fichier construit contient, dans l'ordre : le score repris de l'ancien fichier, des victoires valides,
+// le début d'un enregistrement interrompu en cours d'écriture, une victoire ajoutée après le redémarrage,
+// des octets quelconques, puis une dernière victoire. À la relecture, chaque victoire doit revenir,
+// le score repris une seule fois, et seuls les octets abîmés doivent être sautés.
+// Compilé sans raylib : make scores && ./leaderboard_check [dossier de travail]
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "leaderboard.h"
+
+using namespace std;
+
+static const size_t TORN_BYTES = 20;  // Octets écrits d'un enregistrement interrompu (sur 48)
+
+static int failures = 0;
+
+static void Check(bool condition, const char* what) {
+    printf("%-60s %s\n", what, condition ? "ok" : "ÉCHEC");
+    if (!condition) failures++;
+}
+
+static vector<unsigned char> ReadBytes(const string& path) {
+    vector<unsigned char> bytes;
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) return bytes;
+    unsigned char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) bytes.insert(bytes.end(), buffer, buffer + read);
+    fclose(file);
+    return bytes;
+}
+
+static void AppendBytes(const string& path, const unsigned char* bytes, size_t size) {
+    FILE* file = fopen(path.c_str(), "ab");
+    if (!file) return;
+    fwrite(bytes, 1, size, file);
+    fclose(file);
+}
+
+// Victoire enregistrée par le test
+struct Win {
+    int level;
+    MazeId id;
+    float seconds;
+};
+
+// Vrai si la victoire a été relue exactement une fois
+static bool FoundOnce(Leaderboard& leaderboard, const Win& win) {
+    int found = 0;
+    for (const Score& score : leaderboard.GetScores()) {
+        found += score.level == win.level && score.id.seed == win.id.seed && score.id.width == win.id.width &&
+                 score.id.height == win.id.height && score.id.algorithm == win.id.algorithm && score.seconds == win.seconds;
+    }
+    return found == 1;
+}
+
+// Nombre de scores repris de l'ancien fichier
+static int LegacyCount(Leaderboard& leaderboard) {
+    int count = 0;
+    for (const Score& score : leaderboard.GetScores()) count += score.level == -1;
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    string directory = argc > 1 ? argv[1] : ".";
+    string path = directory + "/leaderboard_check.dat";
+    string legacyPath = directory + "/leaderboard_check_best_time.txt";
+    remove(path.c_str());
+    FILE* legacy = fopen(legacyPath.c_str(), "w");
+    if (!legacy) {
+        fprintf(stderr, "impossible d'écrire dans %s\n", directory.c_str());
+        return 1;
+    }
+    fprintf(legacy, "12.4414\n");
+    fclose(legacy);
+
+    vector<Win> wins;
+    for (int i = 0; i < 6; i++) wins.push_back(Win{i % 3, MazeId{1000u + i, 20, 15, (MazeAlgorithm)(i % ALGORITHM_COUNT)}, 10.0f + i});
+    Win afterCrash = {1, MazeId{42, 20, 15, PRIM}, 7.5f};
+    Win last = {2, MazeId{43, 64, 64, WILSON}, 31.25f};
+
+    // Premier lancement : pas encore de fichier des scores, le meilleur temps de l'ancien fichier est repris
+    Leaderboard leaderboard;
+    leaderboard.Load(path.c_str(), legacyPath.c_str());
+    Check(LegacyCount(leaderboard) == 1 && leaderboard.GetBestTime(-1) == 12.4414f, "reprise de l'ancien meilleur temps");
+    for (const Win& win : wins) leaderboard.Add(win.level, win.id, win.seconds);
+    leaderboard.Flush();
+
+    // Arrêt pendant une écriture : seul le début d'un enregistrement (ici une copie du premier) atteint le disque
+    vector<unsigned char> bytes = ReadBytes(path);
+    Check(bytes.size() == (wins.size() + 1) * 48, "un enregistrement de 48 octets par score");
+    AppendBytes(path, bytes.data(), TORN_BYTES);
+
+    // Redémarrage : la relecture saute l'enregistrement interrompu, puis une victoire est ajoutée à sa suite
+    leaderboard.Load(path.c_str(), legacyPath.c_str());
+    Check(leaderboard.GetSkippedBytes() == (long)TORN_BYTES, "enregistrement interrompu sauté à la fin du fichier");
+    leaderboard.Add(afterCrash.level, afterCrash.id, afterCrash.seconds);
+    leaderboard.Flush();
+
+    // Octets quelconques entre deux enregistrements, dont une fausse signature, puis une dernière victoire
+    const unsigned char garbage[] = {'L', 'D', 'B', '1', 0xFF, 0x00, 0x13, 0x37, 'x', 'y', 'z'};
+    AppendBytes(path, garbage, sizeof(garbage));
+    leaderboard.Add(last.level, last.id, last.seconds);
+    leaderboard.Flush();
+
+    // Relecture complète : toutes les victoires, l'ancien score une seule fois, seuls les octets abîmés sautés
+    leaderboard.Load(path.c_str(), legacyPath.c_str());
+    bool all = FoundOnce(leaderboard, afterCrash) && FoundOnce(leaderboard, last);
+    for (const Win& win : wins) all = all && FoundOnce(leaderboard, win);
+    Check(all, "chaque victoire relue une fois");
+    Check(leaderboard.GetScores().size() == wins.size() + 3, "aucun score en trop");
+    Check(LegacyCount(leaderboard) == 1, "ancien meilleur temps repris une seule fois");
+    Check(leaderboard.GetSkippedBytes() == (long)(TORN_BYTES + sizeof(garbage)), "seuls les octets abîmés sont sautés");
+    Check(leaderboard.GetBestTime(1) == afterCrash.seconds, "meilleur temps du niveau après la reprise");
+    Check(leaderboard.GetBestTime(2, last.id) == last.seconds, "meilleur temps d'un labyrinthe");
+
+    remove(path.c_str());
+    remove(legacyPath.c_str());
+    printf("%s\n", failures ? "tableau des scores : ÉCHEC" : "tableau des scores : ok");
+    return failures ? 1 : 0;
+}
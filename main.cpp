@@ -1,383 +1,37 @@
 #include <raylib.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <time.h> 
 #include <limits> 
-#include <fstream>
 #include <string>
 #include <cmath> 
+#include <algorithm>
+#include <chrono>
+#include "simulation.h"
+#include "frame_profiler.h"
+#include "asset_cache.h"
+#include "leaderboard.h"
+#include "maze_file.h"
+#include "maze_renderer.h"
 
 using namespace std; 
 
 // Constants
-#define SCREEN_WIDTH 800    // Définition de la largeur de la fenêtre d'affichage (en pixels)
-#define SCREEN_HEIGHT 600   // Définition de la hauteur de la fenêtre d'affichage (en pixels)
-#define CELL_SIZE 40        // Définition de la taille d'une cellule du labyrinthe (en pixels)
-#define GRID_WIDTH (SCREEN_WIDTH / CELL_SIZE)  // Calcul du nombre de cellules en largeur en fonction de la taille de la fenêtre et de la taille de la cellule
-#define GRID_HEIGHT (SCREEN_HEIGHT / CELL_SIZE) // Calcul du nombre de cellules en hauteur en fonction de la taille de la fenêtre et de la taille de la cellule
+#define INTRO_MUSIC "tom-and-jerry-ringtone (online-audio-converter.com).wav"  // Musique de l'écran d'accueil
+#define LEADERBOARD_FILE "leaderboard.dat"  // Tableau des scores (remplace best_time.txt, repris au premier lancement)
+#define SIM_STEP (1.0f / 60.0f)  // Pas fixe de la simulation (en secondes), indépendant de la fréquence d'affichage
+#define MAX_FRAME_TIME 0.25f     // Temps maximal rattrapé en une image (évite l'emballement après un blocage)
 // Structures
-class Position {  // Définition d'une classe représentant une position avec des coordonnées x et y
-public:
-    int x, y;  // Déclaration des variables membres x et y représentant la position
-
-    // Constructeur qui initialise les valeurs x et y à 0 par défaut, mais peut être modifié avec des valeurs spécifiques
-    Position(int x = 0, int y = 0) : x(x), y(y) {}
-}; 
-
-class Cell {
-public:
-    bool visited;           // Variable indiquant si la cellule a été visitée ou non (utile pour l'algorithme de génération de labyrinthes)
-    bool topWall, bottomWall, leftWall, rightWall; // Variables pour les murs de la cellule (chaque mur est représenté par un booléen)
-
-    // Constructeur par défaut
-    Cell() : visited(false), topWall(true), bottomWall(true), leftWall(true), rightWall(true) {}
-    // Le constructeur initialise les valeurs des membres de la classe :
-    // - visited est initialisé à false (la cellule n'a pas été visitée)
-    // - tous les murs (haut, bas, gauche, droite) sont initialisés à true (les murs sont présents)
-};
-
-class Niveau {
-public:
-    enum Level { FACILE, MOYEN, DIFFICILE };  // Définition d'un énuméré pour les trois niveaux de difficulté
-    Level niveau;  // Variable membre qui représente le niveau actuel
-
-    // Constructeur qui initialise le niveau à MOYEN par défaut, mais permet de définir un autre niveau si nécessaire
-    Niveau(Level level = MOYEN) : niveau(level) {}
-
-    // Fonction qui retourne la densité des obstacles en fonction du niveau choisi
-    float getObstacleDensity() {
-        switch (niveau) {
-            case FACILE: return 0.3f;   // Pour le niveau facile, la densité des obstacles est de 30%
-            case MOYEN: return 0.5f;    // Pour le niveau moyen, la densité des obstacles est de 50%
-            case DIFFICILE: return 0.7f; // Pour le niveau difficile, la densité des obstacles est de 70%
-        }
-    }
-
-    // Fonction qui indique si le niveau est dynamique (seulement le niveau difficile est dynamique)
-    bool isDynamic() {
-        return niveau == DIFFICILE; // Si le niveau est difficile, la fonction retourne true, sinon false
-    }
-};
-
-class Game; // Forward declaration
-
-class Obstacle {
-public:
-    Position position;        // La position de l'obstacle dans le labyrinthe (utilise la classe Position pour gérer les coordonnées x et y)
-    float moveTimer;          // Un compteur de temps qui permet de contrôler le déplacement de l'obstacle
-    float moveInterval;       // L'intervalle de temps entre chaque déplacement de l'obstacle (en secondes)
-    Texture2D texture;        // Texture de l'obstacle (ex. image qui représente l'obstacle)
-
-    // Constructeur qui initialise la position, le timer de mouvement, l'intervalle et la texture de l'obstacle
-    Obstacle(int x = 0, int y = 0, float interval = 100.0f, const char* texturePath = "Spike.png") 
-        : position(x, y), moveTimer(0), moveInterval(interval) {
-        texture = LoadTexture(texturePath); // Charge la texture spécifiée pour l'obstacle
-    }
-
-    // Destructeur qui décharge la texture quand l'obstacle n'est plus nécessaire
-    ~Obstacle() {
-        UnloadTexture(texture);  // Décharge la texture de la mémoire
-    }
-
-    // Fonction qui permet de changer la texture de l'obstacle
-    void SetTexture(const char* texturePath) {
-        UnloadTexture(texture);  // Décharge la texture actuelle
-        texture = LoadTexture(texturePath);  // Charge la nouvelle texture
-    }
-
-    // Fonction qui fait déplacer l'obstacle dans le labyrinthe
-    void Move() {
-
-        moveTimer += GetFrameTime();  // Incrémente le timer de mouvement en fonction du temps écoulé entre deux images
-    
-        if (moveTimer >= moveInterval) {  // Si l'intervalle de déplacement est atteint
-            // Déplace l'obstacle dans une direction aléatoire
-            position.x += GetRandomValue(-2, 2);
-            position.y += GetRandomValue(-2, 2);
-
-            // Limite les déplacements de l'obstacle pour qu'il reste dans les limites du labyrinthe
-            if (position.x < 0) position.x = 0;
-            if (position.x >= GRID_WIDTH) position.x = GRID_WIDTH - 1;
-            if (position.y < 0) position.y = 0;
-            if (position.y >= GRID_HEIGHT) position.y = GRID_HEIGHT - 1;
-
-            moveTimer = 0;  // Réinitialise le timer pour le prochain déplacement
-        }
-    }
-
-    // Fonction qui dessine l'obstacle à l'écran avec mise à l'échelle et décalage
-    void Draw(float scaleFactor, int offsetX, int offsetY) {
-        int scaledCellSize = scaleFactor * SCREEN_WIDTH / GRID_WIDTH;  // Calcul de la taille de la cellule mise à l'échelle
-        int posX = offsetX + position.x * scaledCellSize;  // Calcul de la position horizontale de l'obstacle
-        int posY = offsetY + position.y * scaledCellSize;  // Calcul de la position verticale de l'obstacle
-
-        // Dessine la texture de l'obstacle à la position spécifiée
-        DrawTexturePro(texture, {0, 0, (float)texture.width, (float)texture.height},
-            {(float)posX, (float)posY, (float)scaledCellSize, (float)scaledCellSize}, {0, 0}, 0, WHITE);
-    }
-
-    // Fonction qui vérifie si l'obstacle est en collision avec le joueur
-    bool CheckCollision(Position player) {
-        // Retourne true si l'obstacle se trouve à la même position que le joueur
-        return (position.x == player.x && position.y == player.y);
-    }
-};
-
-class Maze {
-private:
-    Cell maze[GRID_WIDTH][GRID_HEIGHT];    // Tableau de cellules représentant le labyrinthe
-    Niveau niveau;                         // Niveau du jeu, définissant la difficulté
-    Obstacle movingObstacle;               // Obstacle qui se déplace dans le labyrinthe
-    int gridWidth, gridHeight;             // Dimensions du labyrinthe
-    Texture2D wallTexture;                 // Texture des murs du labyrinthe
-
-    // Génère un chemin dans le labyrinthe en utilisant un algorithme de backtracking
-    void GeneratePath(int x, int y) {
-        maze[x][y].visited = true;  // Marque la cellule actuelle comme visitée
-        while (true) {
-            // Tableau de directions possibles : 0 = haut, 1 = droite, 2 = bas, 3 = gauche
-            int directions[] = {0, 1, 2, 3}; 
-            
-            // Mélange aléatoirement les directions pour diversifier le parcours
-            for (int i = 0; i < 4; i++) {
-                int j = GetRandomValue(i, 3);
-                int temp = directions[i];
-                directions[i] = directions[j];
-                directions[j] = temp;
-            }
-
-            bool moved = false;  // Indicateur si un mouvement a été effectué
-            for (int i = 0; i < 4; i++) {
-                int nx = x, ny = y;
-                // Calcul de la nouvelle position en fonction de la direction
-                if (directions[i] == 0) ny -= 1;  // Haut
-                else if (directions[i] == 1) nx += 1;  // Droite
-                else if (directions[i] == 2) ny += 1;  // Bas
-                else if (directions[i] == 3) nx -= 1;  // Gauche
-
-                // Vérifie si la nouvelle position est valide et si la cellule n'est pas visitée
-                if (nx >= 0 && nx < gridWidth && ny >= 0 && ny < gridHeight && !maze[nx][ny].visited) {
-                    // Supprime les murs entre la cellule actuelle et la cellule voisine
-                    if (directions[i] == 0) {
-                        maze[x][y].topWall = false;
-                        maze[nx][ny].bottomWall = false;
-                    } else if (directions[i] == 1) {
-                        maze[x][y].rightWall = false;
-                        maze[nx][ny].leftWall = false;
-                    } else if (directions[i] == 2) {
-                        maze[x][y].bottomWall = false;
-                        maze[nx][ny].topWall = false;
-                    } else if (directions[i] == 3) {
-                        maze[x][y].leftWall = false;
-                        maze[nx][ny].rightWall = false;
-                    }
-                    GeneratePath(nx, ny);  // Récursion pour continuer à générer le chemin
-                    moved = true;
-                    break;  // Sort de la boucle dès qu'un mouvement est effectué
-                }
-            }
-            if (!moved) break;  // Si aucun mouvement n'est possible, on arrête le processus
-        }
-    }
-
-public:
-    // Retourne une référence à l'obstacle qui se déplace dans le labyrinthe
-    Obstacle& GetMovingObstacle() {
-     return movingObstacle;  // Retourne l'obstacle mobile
-    }
-
-    // Constructeur qui initialise le labyrinthe avec la difficulté choisie et génère le chemin
-    Maze(Niveau::Level level) : niveau(level), movingObstacle(0, 0, 0.5f) {
-        gridWidth = GRID_WIDTH;
-        gridHeight = GRID_HEIGHT;
-
-        wallTexture = LoadTexture("brick.png");  // Charger la texture des murs
-        InitializeMaze();  // Initialise le labyrinthe avec des murs
-        GeneratePath(0, 0);  // Génère le chemin à partir de la position initiale (0, 0)
-    }
-
-    // Destructeur qui libère la mémoire utilisée par la texture des murs
-    ~Maze() {
-        UnloadTexture(wallTexture);  // Libère la texture utilisée pour les murs
-    }
-
-    // Initialise toutes les cellules du labyrinthe avec des murs et non visitées
-    void InitializeMaze() {
-        for (int x = 0; x < gridWidth; x++) {
-            for (int y = 0; y < gridHeight; y++) {
-                maze[x][y].visited = false;  // Marque la cellule comme non visitée
-                maze[x][y].topWall = true;   // Initialise le mur supérieur
-                maze[x][y].bottomWall = true; // Initialise le mur inférieur
-                maze[x][y].leftWall = true;  // Initialise le mur gauche
-                maze[x][y].rightWall = true; // Initialise le mur droit
-            }
-        }
-    }
-
-    // Regénère le labyrinthe à partir de la position actuelle du joueur
-    void Regenerate(Position playerPosition) {
-        InitializeMaze();  // Réinitialise le labyrinthe
-        GeneratePath(playerPosition.x, playerPosition.y);  // Re-génère un nouveau chemin à partir de la position du joueur
-    }
-
-    // Dessine le labyrinthe à l'écran
-    void DrawMaze(Position player) {
-        float scaleFactor = 0.75f; // Facteur d'échelle pour ajuster la taille du labyrinthe
-        int reducedWidth = scaleFactor * SCREEN_WIDTH;  // Largeur réduite en fonction du facteur d'échelle
-        int reducedHeight = scaleFactor * SCREEN_HEIGHT; // Hauteur réduite en fonction du facteur d'échelle
-
-        int offsetX = (SCREEN_WIDTH - reducedWidth) / 2; // Décalage horizontal pour centrer le labyrinthe
-        int offsetY = (SCREEN_HEIGHT - reducedHeight) / 2; // Décalage vertical pour centrer le labyrinthe
-
-        int scaledCellSize = reducedWidth / GRID_WIDTH;  // Taille des cellules mise à l'échelle
-        int lineThickness = 4;  // Épaisseur des murs du labyrinthe
-
-        // Dessine chaque cellule du labyrinthe
-        for (int x = 0; x < gridWidth; x++) {
-            for (int y = 0; y < gridHeight; y++) {
-                int posX = offsetX + x * scaledCellSize;
-                int posY = offsetY + y * scaledCellSize;
-
-                // Dessine le mur supérieur
-                if (maze[x][y].topWall) {
-                    DrawTexturePro(
-                        wallTexture,
-                        (Rectangle){0, 0, wallTexture.width, wallTexture.height},
-                        (Rectangle){posX, posY, scaledCellSize, lineThickness},
-                        (Vector2){0, 0},
-                        0.0f,
-                        WHITE
-                    );
-                }
-                // Dessine le mur droit
-                if (maze[x][y].rightWall) {
-                    DrawTexturePro(
-                        wallTexture,
-                        (Rectangle){0, 0, wallTexture.width, wallTexture.height},
-                        (Rectangle){posX + scaledCellSize - lineThickness, posY, lineThickness, scaledCellSize},
-                        (Vector2){0, 0},
-                        0.0f,
-                        WHITE
-                    );
-                }
-                // Dessine le mur inférieur
-                if (maze[x][y].bottomWall) {
-                    DrawTexturePro(
-                        wallTexture,
-                        (Rectangle){0, 0, wallTexture.width, wallTexture.height},
-                        (Rectangle){posX, posY + scaledCellSize - lineThickness, scaledCellSize, lineThickness},
-                        (Vector2){0, 0},
-                        0.0f,
-                        WHITE
-                    );
-                }
-                // Dessine le mur gauche
-                if (maze[x][y].leftWall) {
-                    DrawTexturePro(
-                        wallTexture,
-                        (Rectangle){0, 0, wallTexture.width, wallTexture.height},
-                        (Rectangle){posX, posY, lineThickness, scaledCellSize},
-                        (Vector2){0, 0},
-                        0.0f,
-                        WHITE
-                    );
-                }
-            }
-        }
-
-        // Si le niveau est moyen, déplacer et dessiner l'obstacle mobile
-        if (niveau.niveau == Niveau::MOYEN) {
-            movingObstacle.Move();  // Déplace l'obstacle
-            movingObstacle.Draw(scaleFactor, offsetX, offsetY);  // Dessine l'obstacle
-        }
-    }
-
-    // Vérifie s'il y a un mur dans la direction donnée par dx et dy
-    bool HasWall(Position player, int dx, int dy) {
-        if (dx == -1 && maze[player.x][player.y].leftWall) return true;  // Vérifie le mur gauche
-        if (dx == 1 && maze[player.x][player.y].rightWall) return true;  // Vérifie le mur droit
-        if (dy == -1 && maze[player.x][player.y].topWall) return true;   // Vérifie le mur supérieur
-        if (dy == 1 && maze[player.x][player.y].bottomWall) return true; // Vérifie le mur inférieur
-        return false;  // Si aucun mur, retourne false
-    }
-
-    // Accesseurs pour obtenir la largeur et la hauteur du labyrinthe
-    int GetGridWidth() const { return gridWidth; }
-    int GetGridHeight() const { return gridHeight; }
-};
-
-class Player {
-public:
-    Position position;            // Position actuelle du joueur dans le labyrinthe
-    int gridWidth, gridHeight;    // Dimensions dynamiques du labyrinthe
-    Texture2D texture;            // Texture pour représenter le joueur
-
-    // Constructeur initialisant la position et la texture du joueur
-    Player(int x = 0, int y = 0, const char* texturePath = "Tom.png") 
-        : position(x, y), gridWidth(GRID_WIDTH), gridHeight(GRID_HEIGHT) {
-        // Charger la texture depuis un fichier
-        texture = LoadTexture(texturePath);
-    }
-
-    // Destructeur pour décharger la texture lorsque l'objet est détruit
-    ~Player() {
-        UnloadTexture(texture);
-    }
-
-    // Définir la taille du labyrinthe pour le joueur
-    void SetGridSize(int width, int height) {
-        gridWidth = width;
-        gridHeight = height;
-    }
-
-    // Fonction pour déplacer le joueur
-    void Move(int dx, int dy, Maze &maze, bool &gameWon) {
-        int newX = position.x + dx;
-        int newY = position.y + dy;
-
-        // Vérifie que le nouveau déplacement est à l'intérieur du labyrinthe
-        if (newX < 0 || newX >= gridWidth || newY < 0 || newY >= gridHeight) return;
-
-        // Vérifie si un mur bloque le déplacement
-        if (maze.HasWall(position, dx, dy)) return;
-
-        // Met à jour la position du joueur
-        position.x = newX;
-        position.y = newY;
-
-        // Vérifie si le joueur a atteint la sortie
-        if (position.x == gridWidth - 1 && position.y == gridHeight - 1) gameWon = true;
-    }
-
-    // Fonction pour dessiner le joueur à sa position actuelle dans le labyrinthe
-    void Draw(float scaleFactor, int offsetX, int offsetY) {
-        int scaledCellSize = scaleFactor * SCREEN_WIDTH / gridWidth;
-        // Calcul de la position du joueur dans le labyrinthe centré
-        int posX = offsetX + position.x * scaledCellSize;
-        int posY = offsetY + position.y * scaledCellSize;
-        int padding = 2; // Padding pour ajuster la taille du joueur
-
-        // Dessine la texture du joueur à la position calculée
-        DrawTexturePro(
-            texture,
-            {0, 0, (float)texture.width, (float)texture.height},  // Source de la texture
-            {(float)posX, (float)posY, (float)scaledCellSize, (float)scaledCellSize}, // Destination
-            {0, 0},  // Origine (aucun décalage)
-            0,       // Pas de rotation
-            WHITE    // Couleur blanche pour conserver l'image originale
-        );
-    }
-};
-
 
 void ShowIntroScreen() { 
     // Charger l'image de fond
-    Texture2D background = LoadTexture("img2.png"); // Remplacez par le chemin de votre image
+    Texture2D background = Assets().AcquireTexture("img2.png"); // Remplacez par le chemin de votre image
 
     // Initialiser le système audio
     InitAudioDevice(); 
 
     // Charger et jouer la musique en boucle
-    Music introMusic = LoadMusicStream("tom-and-jerry-ringtone (online-audio-converter.com).wav"); // Remplacez par le chemin de votre fichier musique
+    Music introMusic = Assets().LoadMusic(INTRO_MUSIC); // Données déjà lues par le préchargement
     PlayMusicStream(introMusic); // Jouer la musique
     SetMusicVolume(introMusic, 0.5f); // Optionnel : ajuster le volume de la musique
 
@@ -437,6 +91,14 @@ void ShowIntroScreen() {
 
         EndDrawing();
 
+        // Temps entre l'ouverture de la fenêtre et la première image de l'accueil (au premier affichage seulement)
+        static bool startupReported = false;
+        if (!startupReported) {
+            TraceLog(LOG_INFO, "STARTUP: première image de l'accueil %.2f ms après l'ouverture de la fenêtre",
+                     Assets().GetMsSincePreload());
+            startupReported = true;
+        }
+
         // Gérer le clic sur le bouton
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), playButton)) {
             StopMusicStream(introMusic); // Arrêter la musique quand l'utilisateur clique sur le bouton
@@ -445,14 +107,15 @@ void ShowIntroScreen() {
     }
 
     // Décharger les ressources
-    UnloadMusicStream(introMusic); // Décharger la musique
-    UnloadTexture(background); // Décharger l'image de fond
+    Assets().UnloadMusic(INTRO_MUSIC, introMusic); // Décharger la musique
+    Assets().Release("img2.png"); // L'image de fond n'est plus utilisée
+    Assets().UnloadUnused(); // L'écran d'accueil n'est plus affiché : libérer son image
     CloseAudioDevice(); // Fermer le système audio
 }
 
 Niveau::Level ShowLevelMenu() {
     // Charger l'image de fond
-    Texture2D background = LoadTexture("img4.png");
+    Texture2D background = Assets().AcquireTexture("img4.png");  // Partagée avec l'écran de victoire
 
     // Calculer l'échelle de l'image pour s'adapter à l'écran
     float scaleX = (float)SCREEN_WIDTH / (float)background.width;
@@ -511,86 +174,98 @@ Niveau::Level ShowLevelMenu() {
         // Gestion des clics
         if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
             // Vérifier quel bouton a été cliqué et retourner le niveau correspondant
-            if (CheckCollisionPointRec(mousePoint, easyButton)) return Niveau::FACILE;
-            if (CheckCollisionPointRec(mousePoint, mediumButton)) return Niveau::MOYEN;
-            if (CheckCollisionPointRec(mousePoint, hardButton)) return Niveau::DIFFICILE;
+            Niveau::Level level = Niveau::MOYEN;
+            bool chosen = true;
+            if (CheckCollisionPointRec(mousePoint, easyButton)) level = Niveau::FACILE;
+            else if (CheckCollisionPointRec(mousePoint, mediumButton)) level = Niveau::MOYEN;
+            else if (CheckCollisionPointRec(mousePoint, hardButton)) level = Niveau::DIFFICILE;
+            else chosen = false;
+
+            if (chosen) {
+                Assets().Release("img4.png");  // Rendre l'image de fond au cache avant de quitter le menu
+                return level;
+            }
         }
     }
 
-    // Décharger la texture de l'image de fond
-    UnloadTexture(background);
+    // Rendre l'image de fond au cache
+    Assets().Release("img4.png");
+    return Niveau::MOYEN;
 }
 
 class Game {
 private:
-    Maze maze;  // Le labyrinthe du jeu
-    Player player;  // Le joueur, représentant Tom
-    Position goal;  // La position de l'objectif (fromage Jerry)
-    bool gameWon;  // Indicateur si le jeu est gagné
-    bool isPaused;  // Indicateur si le jeu est en pause
-    float timer;  // Chronomètre du jeu
-    float changeTimer;  // Timer pour régénérer le labyrinthe
-    float bestTime;  // Meilleur temps du joueur
-    Niveau niveau;  // Niveau de difficulté
+    Simulation sim;  // État de la partie (labyrinthe, joueur, obstacle, chronomètres), sans raylib
+    MazeView view;  // Disposition du labyrinthe à l'écran (fixe ou caméra qui suit le joueur)
+    MazeRenderer mazeRenderer;  // Dessin des murs du labyrinthe
+    float bestTime;  // Meilleur temps du joueur sur ce niveau
+    vector<string> spritePaths;  // Fichiers des sprites obtenus du cache, rendus par le destructeur
+    Sprite playerTexture;  // Sprite du joueur (Tom)
+    Sprite obstacleTexture;  // Sprite partagé par tous les obstacles mobiles
     Rectangle resetButton;  // Bouton pour réinitialiser le jeu
-    Texture2D resetButtonTexture;  // Texture du bouton Reset
+    Sprite resetButtonTexture;  // Sprite du bouton Reset
     Rectangle homeButton;  // Bouton pour revenir à l'écran d'accueil
-    Texture2D homeButtonTexture;  // Texture du bouton d'accueil
+    Sprite homeButtonTexture;  // Sprite du bouton d'accueil
     Rectangle retryButton;  // Bouton pour recommencer
     Rectangle quitButton;  // Bouton pour quitter
     Rectangle pauseButton;  // Bouton pour mettre en pause
-    Texture2D goalTexture;  // Texture pour le point d'arrivée (fromage)
-    Texture2D timerIcon;  // Texture pour l'icône du timer
-    Texture2D backgroundTexture;  // Texture pour l'arrière-plan du jeu
-    Texture2D pauseTexture;  // Texture pour le bouton de pause
-    Texture2D resumeTexture;  // Texture pour le bouton de reprise
+    Sprite goalTexture;  // Sprite pour le point d'arrivée (fromage)
+    Sprite timerIcon;  // Sprite pour l'icône du timer
+    Sprite backgroundTexture;  // Texture pour l'arrière-plan du jeu
+    Sprite pauseTexture;  // Sprite pour le bouton de pause
+    Sprite resumeTexture;  // Sprite pour le bouton de reprise
+    float accumulator;  // Temps écoulé pas encore simulé (moins d'un pas fixe après la boucle de mise à jour)
+    SimInput pendingInput;  // Commandes lues depuis le dernier pas de simulation
+    FrameProfiler profiler;  // Durées des phases des dernières images
+    bool showProfiler;  // Surimpression des temps par phase (touche F3)
+    bool showHint;  // Chemin vers la sortie affiché devant le joueur (touche H)
+    chrono::steady_clock::time_point createdAt;  // Choix du niveau (création de la partie)
+    bool firstFrameShown;  // Vrai une fois la première image de la partie présentée
+
+    // Obtient un sprite du cache partagé (chargé une seule fois, même si plusieurs parties se succèdent)
+    Sprite AcquireSprite(const char* path) {
+        spritePaths.push_back(path);
+        return Assets().AcquireSprite(path);
+    }
 
 public:
     // Constructeur de la classe Game
-    Game(Niveau::Level level, const char* playerTexturePath = "Tom.png", const char* obstacleTexturePath = "Spike.png", 
+    Game(Niveau::Level level, int gridWidth = GRID_WIDTH, int gridHeight = GRID_HEIGHT, uint64_t seed = Rng::SeedFromClock(), const char* playerTexturePath = "Tom.png", const char* obstacleTexturePath = "Spike.png", 
          const char* goalTexturePath = "jerry.png", const char* timerIconPath = "magana.png", 
          const char* BackgroundTexturePath = "img4.png", const char* resetButtonTexturePath = "reset.png", 
          const char* homeButtonTexturePath = "home.png")
-    : player(0, 0, playerTexturePath), gameWon(false), isPaused(false), timer(0), changeTimer(0), bestTime(-1), niveau(level), maze(level) {
+    : sim(level, gridWidth, gridHeight, seed), view(gridWidth, gridHeight), bestTime(-1), accumulator(0), showProfiler(false), showHint(false),
+      createdAt(chrono::steady_clock::now()), firstFrameShown(false) {
         
-        // Initialisation de l'objectif, boutons et autres textures
-        goal = Position(GRID_WIDTH - 1, GRID_HEIGHT - 1);  // Position de l'objectif (fromage Jerry)
+        // Initialisation des boutons et des textures
         resetButton = {SCREEN_WIDTH -730, 16, 42, 42};  // Position du bouton Reset
         homeButton = {SCREEN_WIDTH - 785,10,57,57};  // Position du bouton Home
-        retryButton = {SCREEN_WIDTH / 2 - 70, SCREEN_HEIGHT / 2 + 80, 140, 40};  // Position du bouton Retry
-        quitButton = {SCREEN_WIDTH / 2 - 70, SCREEN_HEIGHT / 2 + 140, 140, 40};  // Position du bouton Quit
+        // Boutons Retry et Quit côte à côte au centre de l'écran de victoire (20 pixels d'écart)
+        retryButton = {SCREEN_WIDTH / 2 - 150, SCREEN_HEIGHT / 2 + 60, 140, 40};  // Position du bouton Retry
+        quitButton = {SCREEN_WIDTH / 2 + 10, SCREEN_HEIGHT / 2 + 60, 140, 40};  // Position du bouton Quit
         pauseButton = {SCREEN_WIDTH - 70, 20, 50, 50};  // Position du bouton Pause
         
-        // Chargement des textures pour les éléments du jeu
-        goalTexture = LoadTexture(goalTexturePath);  // Charger la texture de l'objectif
-        backgroundTexture = LoadTexture(BackgroundTexturePath);  // Charger la texture de l'arrière-plan
-        timerIcon = LoadTexture(timerIconPath);  // Charger l'icône du timer
-        resetButtonTexture = LoadTexture(resetButtonTexturePath);  // Charger la texture du bouton Reset
-        homeButtonTexture = LoadTexture(homeButtonTexturePath);  // Charger la texture du bouton Home
-        pauseTexture = LoadTexture("pause60.png");  // Charger la texture du bouton Pause
-        resumeTexture = LoadTexture("resume60.png");  // Charger la texture du bouton Resume
-
-        // Charger la texture de l'obstacle du labyrinthe
-        maze.GetMovingObstacle().SetTexture(obstacleTexturePath);
-
-        // Charger le meilleur temps du fichier
-        std::ifstream infile("best_time.txt");
-        if (infile.is_open()) {
-            infile >> bestTime;  // Lire le meilleur temps enregistré
-            infile.close();
-        }
+        // Sprites des éléments du jeu, pris dans l'atlas partagé (les petites images) ou dans le cache
+        goalTexture = AcquireSprite(goalTexturePath);  // Sprite de l'objectif
+        backgroundTexture = AcquireSprite(BackgroundTexturePath);  // Image de l'arrière-plan
+        timerIcon = AcquireSprite(timerIconPath);  // Icône du timer
+        resetButtonTexture = AcquireSprite(resetButtonTexturePath);  // Sprite du bouton Reset
+        homeButtonTexture = AcquireSprite(homeButtonTexturePath);  // Sprite du bouton Home
+        pauseTexture = AcquireSprite("pause60.png");  // Sprite du bouton Pause
+        resumeTexture = AcquireSprite("resume60.png");  // Sprite du bouton Resume
+
+        // Sprites du joueur et des obstacles du labyrinthe
+        playerTexture = AcquireSprite(playerTexturePath);
+        obstacleTexture = AcquireSprite(obstacleTexturePath);
+
+        // Meilleur temps du niveau, pris dans le tableau des scores chargé pendant l'écran d'accueil
+        bestTime = Scores().GetBestTime(level);
     }
 
-    // Destructeur pour libérer les ressources
+    // Destructeur pour rendre les ressources au cache
     ~Game() {
-        // Libérer les textures des éléments chargés dans le constructeur
-        UnloadTexture(resetButtonTexture);  // Libérer la texture du bouton Reset
-        UnloadTexture(homeButtonTexture);  // Libérer la texture du bouton Home
-        UnloadTexture(goalTexture);  // Libérer la texture de l'objectif
-        UnloadTexture(backgroundTexture);  // Libérer la texture de l'arrière-plan
-        UnloadTexture(timerIcon);  // Libérer l'icône du timer
-        UnloadTexture(pauseTexture);  // Libérer la texture du bouton Pause
-        UnloadTexture(resumeTexture);  // Libérer la texture du bouton Resume
+        // Rendre au cache les sprites obtenus dans le constructeur (ils restent chargés pour la partie suivante)
+        for (const string& path : spritePaths) Assets().Release(path.c_str());
     }
 
     // Fonction pour afficher l'écran d'introduction et réinitialiser le jeu
@@ -604,11 +279,11 @@ public:
         while (true) {
             Niveau::Level level = ShowLevelMenu();  // Afficher le menu de sélection du niveau
 
-            // Créer une nouvelle instance de Game avec le niveau choisi
-            Game game(level);
+            // Créer une nouvelle instance de Game avec le niveau choisi et la même taille de labyrinthe
+            Game game(level, sim.maze.GetGridWidth(), sim.maze.GetGridHeight());
+            if (sim.fixedMaze) game.LoadFixedMaze(sim.maze.GetId(), sim.maze.GetGrid());  // Même labyrinthe du paquet
             game.Initialize();  // Initialiser le jeu avec ce niveau
 
-            SetTargetFPS(60);  // Définir le nombre de FPS à 60 pour une expérience fluide
             bool retry = false;
             do {
                 retry = game.Update();  // Mettre à jour l'état du jeu à chaque frame
@@ -619,65 +294,62 @@ public:
     }
 
     // Fonction pour dessiner l'objectif (fromage Jerry) dans le labyrinthe
-    void DrawGoal(float scaleFactor, int offsetX, int offsetY) {
-        // Calcul des dimensions de chaque cellule dans le labyrinthe
-        int cellWidth = SCREEN_WIDTH / maze.GetGridWidth() * scaleFactor;
-        int cellHeight = SCREEN_HEIGHT / maze.GetGridHeight() * scaleFactor;
-
+    void DrawGoal(const MazeView& view) {
         // Calcul de la position de l'objectif dans le labyrinthe
         Vector2 goalPosition = {
-            offsetX + goal.x * cellWidth,
-            offsetY + goal.y * cellHeight
+            (float)(view.offsetX + sim.goal.x * view.cellSize),
+            (float)(view.offsetY + sim.goal.y * view.cellSize)
         };
 
-        // Dessiner l'objectif (fromage Jerry) à la position calculée
-        DrawTextureEx(goalTexture, goalPosition, 0.0f, scaleFactor, WHITE);
+        // Dessiner l'objectif (fromage Jerry) à la position calculée, à l'échelle de la cellule
+        float scale = (float)view.cellSize / CELL_SIZE;
+        DrawTexturePro(goalTexture.texture, goalTexture.source,
+            {goalPosition.x, goalPosition.y, goalTexture.source.width * scale, goalTexture.source.height * scale},
+            {0, 0}, 0.0f, WHITE);
+    }
+
+    // Position interpolée entre deux pas de simulation (alpha = fraction du pas suivant déjà écoulée)
+    static float Interpolate(int previous, int current, float alpha) {
+        return previous + (current - previous) * alpha;
+    }
+
+    // Dessine une texture sur la cellule (cellX, cellY) du labyrinthe ; les coordonnées peuvent être
+    // fractionnaires pour un élément interpolé entre deux cases
+    static void DrawInCell(const Sprite& sprite, float cellX, float cellY, const MazeView& view) {
+        float posX = view.offsetX + cellX * view.cellSize;
+        float posY = view.offsetY + cellY * view.cellSize;
+        DrawTexturePro(
+            sprite.texture,
+            sprite.source,  // Zone du sprite dans sa texture
+            {posX, posY, (float)view.cellSize, (float)view.cellSize}, // Destination
+            {0, 0},  // Origine (aucun décalage)
+            0,       // Pas de rotation
+            WHITE    // Couleur blanche pour conserver l'image originale
+        );
     }
 
     // Fonction d'initialisation du jeu
     void Initialize() {
-        // Initialiser les variables du jeu
-        player.position = Position(0, 0);  // Placer le joueur au début du labyrinthe
-        gameWon = false;  // Le jeu n'est pas gagné au début
-        timer = 0;  // Réinitialiser le chronomètre
-        changeTimer = 0;  // Réinitialiser le timer de régénération du labyrinthe
-
-        // Mettre à jour la taille de la grille du joueur
-        player.SetGridSize(maze.GetGridWidth(), maze.GetGridHeight());
-    }
-
-    // Fonction pour sauvegarder le meilleur temps dans un fichier
-    void SaveBestTime() {
-        std::ofstream outfile("best_time.txt");
-        if (outfile.is_open()) {
-            outfile << bestTime;  // Sauvegarder le meilleur temps
-            outfile.close();
-        }
+        sim.Initialize();  // Placer le joueur au début et remettre les chronomètres à zéro
+        accumulator = 0;
+        pendingInput = SimInput();
+    }
+
+    // Joue un labyrinthe lu dans un paquet de niveaux (aux dimensions de la partie) au lieu d'un labyrinthe généré
+    void LoadFixedMaze(const MazeId& id, const MazeGrid& walls) {
+        sim.LoadFixedMaze(id, walls);
     }
 
     // Fonction pour réinitialiser le jeu
     void ResetGame() {
-        // Réinitialiser la position du joueur
-        player.position = Position(0, 0);
-        gameWon = false;  // Réinitialiser l'état de victoire
-        timer = 0;  // Réinitialiser le chronomètre
-        changeTimer = 0;  // Réinitialiser le timer de régénération
-        maze.Regenerate(player.position);  // Régénérer le labyrinthe
-        player.SetGridSize(maze.GetGridWidth(), maze.GetGridHeight());  // Mettre à jour la taille de la grille du joueur
+        sim.Reset();  // Replacer le joueur, remettre les chronomètres à zéro et régénérer le labyrinthe
     }
-    bool Update() {
-    if (gameWon) {
-        // Vérifier si le joueur a gagné et si le temps actuel est meilleur que le meilleur temps
-        if (bestTime < 0 || timer < bestTime) {
-            bestTime = timer;
-            SaveBestTime();  // Sauvegarder le meilleur temps
-        }
-
-        BeginDrawing();
+    // Dessine l'écran de victoire (image de fond, scores, boutons Retry et Quit)
+    void DrawWinScreen(Vector2 mousePoint) {
         ClearBackground(BLACK);  // Effacer l'écran avec un fond noir
 
         // Dessiner l'image de fond
-        DrawTexture(backgroundTexture, 0, 0, WHITE);
+        DrawTexture(backgroundTexture.texture, 0, 0, WHITE);
 
         // Couleur dynamique pour "YOU WIN!"
         float time = GetTime();  // Temps écoulé
@@ -691,17 +363,11 @@ public:
 
         // Afficher les scores au centre
         DrawText("Score Actuel :", SCREEN_WIDTH / 2 - 120, SCREEN_HEIGHT / 2 - 60, 20, BLACK);
-        DrawText(TextFormat("%02d:%02d", (int)timer / 60, (int)timer % 60), SCREEN_WIDTH / 2 + 50, SCREEN_HEIGHT / 2 - 60, 20, BLACK);
+        DrawText(TextFormat("%02d:%02d", (int)sim.timer / 60, (int)sim.timer % 60), SCREEN_WIDTH / 2 + 50, SCREEN_HEIGHT / 2 - 60, 20, BLACK);
 
         DrawText("Best Time :", SCREEN_WIDTH / 2 - 100, SCREEN_HEIGHT / 2 - 20, 20, BLACK);
         DrawText(TextFormat("%02d:%02d", (int)bestTime / 60, (int)bestTime % 60), SCREEN_WIDTH / 2 + 30, SCREEN_HEIGHT / 2 - 20, 20, BLACK);
 
-        int bestMinutes = (int)bestTime / 60;
-        int bestSeconds = (int)bestTime % 60;
-
-        // Obtenir la position de la souris
-        Vector2 mousePoint = GetMousePosition();
-
         // Définir les couleurs par défaut pour les boutons
         Color retryButtonColor = WHITE;
         Color quitButtonColor = WHITE;
@@ -720,16 +386,6 @@ public:
             quitTextColor = WHITE;       // Couleur du texte lorsqu'on survole
         }
 
-        // Calculer la largeur totale des boutons (y compris l'espace entre eux)
-        int totalButtonWidth = retryButton.width + quitButton.width + 20; // 20 pour l'espace entre les boutons
-
-        // Positionner les boutons horizontalement au centre de l'écran
-        retryButton.x = SCREEN_WIDTH / 2 - totalButtonWidth / 2;  // Déplacer "Retry" à gauche
-        quitButton.x = retryButton.x + retryButton.width + 20;   // Déplacer "Quit" à droite du bouton "Retry"
-
-        // Garder la même position verticale
-        retryButton.y = quitButton.y = SCREEN_HEIGHT / 2 + 60;
-
         // Dessiner le bouton "Retry" avec les couleurs mises à jour
         DrawRectangleRec(retryButton, retryButtonColor);
         int retryTextWidth = MeasureText("Retry", 20);
@@ -743,157 +399,342 @@ public:
         int quitTextX = quitButton.x + (quitButton.width - quitTextWidth) / 2;
         int quitTextY = quitButton.y + (quitButton.height - 20) / 2;
         DrawText("Quit", quitTextX, quitTextY, 20, quitTextColor);
+    }
 
-        // Vérifier si le joueur clique sur le bouton "Retry" ou "Quit"
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            Vector2 mousePoint = GetMousePosition();
-            if (CheckCollisionPointRec(mousePoint, retryButton)) {
-                return true;  // Redémarrer le jeu
-            }
-            if (CheckCollisionPointRec(mousePoint, quitButton)) {
-                CloseWindow();  // Fermer la fenêtre et quitter le jeu
-                return false;   // Quitter le jeu
-            }
-        }
+    // Dessine le labyrinthe, les obstacles, l'objectif et le joueur (à travers la caméra si le labyrinthe défile).
+    // Les éléments mobiles sont interpolés entre les deux derniers pas de simulation.
+    void DrawWorld(float alpha) {
+        float playerX = Interpolate(sim.player.previousPosition.x, sim.player.position.x, alpha);
+        float playerY = Interpolate(sim.player.previousPosition.y, sim.player.position.y, alpha);
 
-        EndDrawing();
-        return false;
+        ClearBackground(Color{240, 220, 190, 255});
+        view.Follow(playerX, playerY);
+        view.BeginWorld();
+        mazeRenderer.DrawMaze(sim.maze, view);  // Dessiner le labyrinthe
+        DrawObstacles(alpha);  // Dessiner les obstacles
+        if (showHint) DrawHint();  // Dessiner le chemin vers la sortie
+        DrawGoal(view);  // Dessiner le point d'arrivée
+        DrawInCell(playerTexture, playerX, playerY, view);  // Dessiner le joueur
+        view.EndWorld();
+    }
+
+    // Dessine les obstacles situés dans la zone visible, tous avec le même sprite
+    void DrawObstacles(float alpha) {
+        const ObstacleSwarm& obstacles = sim.obstacles;
+        int x0, y0, x1, y1;
+        view.GetVisibleCells(x0, y0, x1, y1);
+        for (int i = 0; i < obstacles.GetCount(); i++) {
+            int x = obstacles.GetX(i), y = obstacles.GetY(i);
+            if (x < x0 - 1 || x >= x1 + 1 || y < y0 - 1 || y >= y1 + 1) continue;  // Marge : un obstacle avance d'une case par pas, le long d'un couloir
+            DrawInCell(obstacleTexture, Interpolate(obstacles.GetPreviousX(i), x, alpha),
+                       Interpolate(obstacles.GetPreviousY(i), y, alpha), view);
+        }
     }
 
-    // Si le niveau est dynamique et que le jeu n'est pas en pause, régénérer le labyrinthe
-    if (niveau.isDynamic() && !isPaused) {
-        changeTimer += GetFrameTime();
-        if (changeTimer >= 3.0f) {
-            maze.Regenerate(player.position);  // Régénérer le labyrinthe
-            player.SetGridSize(maze.GetGridWidth(), maze.GetGridHeight());
-            changeTimer = 0;
+    // Dessine les HINT_LENGTH prochains pas du chemin le plus court vers la sortie, lus dans le champ de distances
+    void DrawHint() {
+        const int HINT_LENGTH = 40;
+        const DistanceField& field = sim.maze.GetDistanceField();
+        int x = sim.player.position.x, y = sim.player.position.y;
+        int dx, dy;
+        for (int i = 0; i < HINT_LENGTH && field.NextStep(x, y, dx, dy); i++) {
+            x += dx;
+            y += dy;
+            DrawCircle(view.offsetX + (int)((x + 0.5f) * view.cellSize), view.offsetY + (int)((y + 0.5f) * view.cellSize),
+                       view.cellSize / 8.0f, Fade(ORANGE, 1.0f - (float)i / HINT_LENGTH));
         }
     }
 
-    float scaleFactor = 0.75f; // Facteur de mise à l'échelle
-    int reducedWidth = scaleFactor * SCREEN_WIDTH;
-    int reducedHeight = scaleFactor * SCREEN_HEIGHT;
+    // Dessine le chronomètre et les boutons de contrôle par-dessus le labyrinthe
+    void DrawHud() {
+        int currentMinutes = (int)sim.timer / 60;
+        int currentSeconds = (int)sim.timer % 60;
 
-    // Calculer les décalages pour centrer le labyrinthe
-    int offsetX = (SCREEN_WIDTH - reducedWidth) / 2;
-    int offsetY = (SCREEN_HEIGHT - reducedHeight) / 2;
+        // Calculer la position centrée pour le texte du timer
+        int fontSize = 20;
+        const char* timeText = TextFormat(" %02d:%02d", currentMinutes, currentSeconds);
 
+        int textWidth = MeasureText(timeText, fontSize); // Largeur du texte
+        int centerX = (SCREEN_WIDTH - textWidth) / 2;   // Position X centrée
+        int posY = 30;                                  // Position Y
 
-    if (niveau.niveau == Niveau::MOYEN ) {
-        if(!isPaused){
-            maze.GetMovingObstacle().Move();  // Déplacer l'obstacle
-            if (maze.GetMovingObstacle().CheckCollision(player.position)) {
-                player.position = Position(0, 0);  // Réinitialiser la position du joueur
-            }
-        }
-        maze.GetMovingObstacle().Draw(scaleFactor, offsetX, offsetY); // Dessiner l'obstacle
-    }
+        // Dessiner l'icône du timer
+        int iconWidth = timerIcon.source.width;
+        int iconPosX = centerX - iconWidth + 15;  // Position X de l'icône
+        int iconPosY = posY - 20;  // Position Y de l'icône
+        DrawTextureRec(timerIcon.texture, timerIcon.source, {(float)iconPosX, (float)iconPosY}, WHITE);  // Dessiner l'icône du timer
 
-    if(!isPaused){
-        bool gameOver = false;
-        // Gérer les mouvements du joueur avec les touches directionnelles
-        if (IsKeyPressed(KEY_RIGHT)) player.Move(1, 0, maze, gameWon);
-        if (IsKeyPressed(KEY_LEFT)) player.Move(-1, 0, maze, gameWon);
-        if (IsKeyPressed(KEY_UP)) player.Move(0, -1, maze, gameWon);
-        if (IsKeyPressed(KEY_DOWN)) player.Move(0, 1, maze, gameWon);
-    }
+        // Afficher le texte du temps à côté de l'icône
+        DrawText(timeText, centerX, posY, fontSize, RED);
+        if (showHint) {
+            uint32_t remaining = sim.maze.GetDistanceField().GetDistance(sim.player.position.x, sim.player.position.y);
+            DrawText(TextFormat("%u pas jusqu'à la sortie", remaining), centerX, posY + 25, 10, DARKGRAY);
+        }
 
-    if(!isPaused)
-        timer += GetFrameTime();  // Mettre à jour le timer
+        DrawTextureRec(pauseTexture.texture, pauseTexture.source, {pauseButton.x, pauseButton.y}, WHITE);  // Afficher le bouton pause
 
-    // Dessiner le point d'arrivée
-    DrawGoal(scaleFactor, offsetX, offsetY);
+        // Afficher les boutons Reset et Home
+        DrawTexturePro(resetButtonTexture.texture, resetButtonTexture.source,
+            {resetButton.x, resetButton.y, resetButton.width, resetButton.height}, {0, 0}, 0.0f, WHITE);
 
-    int currentMinutes = (int)timer / 60;
-    int currentSeconds = (int)timer % 60;
+        DrawTexturePro(homeButtonTexture.texture, homeButtonTexture.source,
+            {homeButton.x, homeButton.y, homeButton.width, homeButton.height}, {0, 0}, 0.0f, WHITE);
+    }
 
-    // Calculer la position centrée pour le texte du timer
-    int fontSize = 20;
-    const char* timeText = TextFormat(" %02d:%02d", currentMinutes, currentSeconds);
+    // Dessine l'écran de pause à la place du labyrinthe
+    void DrawPauseScreen() {
+        ClearBackground(Color{240, 220, 190, 255});
+        DrawTextureRec(resumeTexture.texture, resumeTexture.source, {pauseButton.x, pauseButton.y}, WHITE);  // Afficher l'icône de reprise
+        DrawText("Game Paused", SCREEN_WIDTH / 2 - MeasureText("Game Paused", 30) / 2, SCREEN_HEIGHT / 2 - 20, 30, BLACK);  // Afficher le texte "Game Paused"
+    }
 
-    int textWidth = MeasureText(timeText, fontSize); // Largeur du texte
-    int centerX = (SCREEN_WIDTH - textWidth) / 2;   // Position X centrée
-    int posY = 30;                                  // Position Y
+    // Affiche les centiles p50/p99 de la durée des images et de chaque phase (touche F3)
+    void DrawProfilerOverlay() {
+        int x = 10, y = SCREEN_HEIGHT - 20 * (FrameProfiler::PHASE_COUNT + 2) - 10;
+        DrawRectangle(x - 5, y - 5, 270, 20 * (FrameProfiler::PHASE_COUNT + 2) + 10, Fade(BLACK, 0.7f));
+        DrawText(TextFormat("image  p50 %6.2f ms  p99 %6.2f ms",
+                            profiler.Percentile(FrameProfiler::PHASE_COUNT, 0.50f),
+                            profiler.Percentile(FrameProfiler::PHASE_COUNT, 0.99f)), x, y, 10, GREEN);
+        for (int phase = 0; phase < FrameProfiler::PHASE_COUNT; phase++) {
+            y += 20;
+            DrawText(TextFormat("%-9s p50 %6.2f ms  p99 %6.2f ms", FrameProfiler::PhaseName(phase),
+                                profiler.Percentile(phase, 0.50f), profiler.Percentile(phase, 0.99f)), x, y, 10, WHITE);
+        }
+        DrawText(TextFormat("%d FPS, %d images (F4 : export CSV)", GetFPS(), profiler.GetCount()), x, y + 20, 10, LIGHTGRAY);
+    }
 
-    BeginDrawing();
-    ClearBackground(Color{240, 220, 190, 255});
-    maze.DrawMaze(player.position);  // Dessiner le labyrinthe
-    player.Draw(scaleFactor, offsetX, offsetY);  // Dessiner le joueur
+    // Une image du jeu : entrées, simulation par pas fixes, puis un seul BeginDrawing/EndDrawing.
+    // Les actions des boutons (recommencer, accueil, quitter) sont appliquées après la fin de l'image.
+    // Retourne true si le joueur veut rejouer.
+    bool Update() {
+    profiler.BeginFrame();
+
+    // Entrées : lues une seule fois par image
+    Vector2 mousePoint = GetMousePosition();
+    bool clicked = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
+    if (IsKeyPressed(KEY_F3)) showProfiler = !showProfiler;  // Afficher ou masquer les temps par phase
+    if (IsKeyPressed(KEY_H)) showHint = !showHint;  // Afficher ou masquer le chemin vers la sortie
+    if (IsKeyPressed(KEY_F4)) {
+        if (profiler.ExportCsv("frame_times.csv")) TraceLog(LOG_INFO, "PROFILER: %d images exportées dans frame_times.csv", profiler.GetCount());
+        else TraceLog(LOG_WARNING, "PROFILER: impossible d'écrire frame_times.csv");
+    }
+
+    // Les commandes sont conservées jusqu'au prochain pas de simulation,
+    // pour ne perdre aucune touche quand l'affichage est plus rapide que la simulation
+    pendingInput.right |= IsKeyPressed(KEY_RIGHT);
+    pendingInput.left |= IsKeyPressed(KEY_LEFT);
+    pendingInput.up |= IsKeyPressed(KEY_UP);
+    pendingInput.down |= IsKeyPressed(KEY_DOWN);
+    if (clicked && CheckCollisionPointRec(mousePoint, pauseButton)) {
+        pendingInput.togglePause = !pendingInput.togglePause;
+    }
+    profiler.Mark(FrameProfiler::INPUT);
+
+    // Avancer la simulation par pas fixes du temps écoulé depuis l'image précédente :
+    // la vitesse du jeu ne dépend plus du nombre d'images par seconde
+    bool wasWon = sim.gameWon;
+    accumulator += min(GetFrameTime(), MAX_FRAME_TIME);
+    while (accumulator >= SIM_STEP && !sim.gameWon) {
+        sim.Step(SIM_STEP, pendingInput);
+        pendingInput = SimInput();  // Les commandes ne s'appliquent qu'une fois
+        accumulator -= SIM_STEP;
+
+        if (sim.mazeChanged && sim.niveau.isDynamic()) {
+            TraceLog(LOG_INFO, "MAZE: régénération construite en %.3f ms, échangée en %.3f ms",
+                     sim.maze.GetLastBuildMs(), sim.maze.GetLastSwapMs());
+        }
+    }
+    if (sim.gameWon) accumulator = 0;  // Plus rien à simuler jusqu'à la prochaine partie
 
-    // Dessiner l'icône du timer
-    int iconWidth = timerIcon.width;
-    int iconHeight = timerIcon.height;
-    int iconPosX = centerX - iconWidth + 15;  // Position X de l'icône
-    int iconPosY = posY - 20;  // Position Y de l'icône
+    // Enregistrer la victoire (écrite dans le fichier par un travail du pool, pas par cette image)
+    if (sim.gameWon && !wasWon) {
+        Scores().Add(sim.niveau.niveau, sim.maze.GetId(), sim.timer);
+        if (bestTime < 0 || sim.timer < bestTime) bestTime = sim.timer;
+    }
+    profiler.Mark(FrameProfiler::SIMULATE);
 
-    DrawTexture(timerIcon, iconPosX, iconPosY, WHITE);  // Dessiner l'icône du timer
+    // Dessin : une seule soumission par image. Le dessin lit l'état sans le modifier.
+    BeginDrawing();
+    if (sim.gameWon) {
+        DrawWinScreen(mousePoint);
+        profiler.Mark(FrameProfiler::MAZE_DRAW);
+    } else if (sim.isPaused) {
+        DrawPauseScreen();
+        profiler.Mark(FrameProfiler::MAZE_DRAW);
+    } else {
+        DrawWorld(accumulator / SIM_STEP);
+        profiler.Mark(FrameProfiler::MAZE_DRAW);
+        DrawHud();
+    }
+    if (showProfiler) DrawProfilerOverlay();
+    profiler.Mark(FrameProfiler::HUD_DRAW);
+    EndDrawing();  // Présentation de l'image (inclut l'attente de la synchronisation verticale)
+    profiler.Mark(FrameProfiler::PRESENT);
+    profiler.EndFrame();
+
+    // Temps entre le choix du niveau et la première image de la partie, dont l'attente des threads de chargement
+    if (!firstFrameShown) {
+        firstFrameShown = true;
+        TraceLog(LOG_INFO, "STARTUP: première image du jeu %.2f ms après le choix du niveau (%.2f ms d'attente du préchargement)",
+                 chrono::duration<double, milli>(chrono::steady_clock::now() - createdAt).count(), Assets().GetWaitMs());
+    }
+
+    // Actions des boutons, une fois l'image terminée
+    if (clicked && sim.gameWon) {
+        if (CheckCollisionPointRec(mousePoint, retryButton)) {
+            return true;  // Redémarrer le jeu
+        }
+        if (CheckCollisionPointRec(mousePoint, quitButton)) {
+            CloseWindow();  // Fermer la fenêtre et quitter le jeu
+            return false;   // Quitter le jeu
+        }
+    } else if (clicked && !sim.isPaused) {
+        if (CheckCollisionPointRec(mousePoint, resetButton)) {
+            ResetGame();  // Réinitialiser le jeu
+        }
+        if (CheckCollisionPointRec(mousePoint, homeButton)) {
+            GoToIntroScreen();  // Réinitialiser tout et afficher l'écran d'accueil
+        }
+    }
+    return false;
+}
+};
 
-    // Afficher le texte du temps
-    DrawText(timeText, centerX, posY, fontSize, RED);  // Afficher le temps
+// Partie sans fin (game endless [graine]) : le labyrinthe est généré par blocs autour du joueur,
+// la caméra le suit sans limite et le score est la plus grande distance atteinte depuis le départ.
+class EndlessGame {
+private:
+    EndlessSimulation sim;      // État de la partie, sans dépendance à raylib
+    MazeView view;              // Caméra sans bornes
+    MazeRenderer mazeRenderer;  // Dessin des blocs visibles
+    Sprite playerTexture;       // Sprite du joueur
+    float accumulator;          // Temps écoulé pas encore simulé
+    SimInput pendingInput;      // Commandes lues depuis le dernier pas de simulation
 
-    // Vérifier si le joueur clique sur le bouton pause/reprise
-    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && CheckCollisionPointRec(GetMousePosition(), pauseButton)) {
-        isPaused = !isPaused;  // Alterner entre pause et reprise
-    }
+public:
+    EndlessGame(uint64_t seed) : sim(seed), view(MazeView::Endless()), accumulator(0) {
+        playerTexture = Assets().AcquireSprite("Tom.png");
+        TraceLog(LOG_INFO, "ENDLESS: graine %016llx, %d blocs de %dx%d au plus en mémoire", (unsigned long long)seed,
+                 sim.maze.GetCapacity(), ChunkedMaze::CHUNK_SIZE, ChunkedMaze::CHUNK_SIZE);
+    }
+
+    ~EndlessGame() {
+        Assets().Release("Tom.png");
+    }
+
+    // Une image : entrées, simulation par pas fixes, puis un seul BeginDrawing/EndDrawing
+    void Update() {
+        pendingInput.right |= IsKeyPressed(KEY_RIGHT);
+        pendingInput.left |= IsKeyPressed(KEY_LEFT);
+        pendingInput.up |= IsKeyPressed(KEY_UP);
+        pendingInput.down |= IsKeyPressed(KEY_DOWN);
+        if (IsKeyPressed(KEY_P)) pendingInput.togglePause = !pendingInput.togglePause;
+        pendingInput.reset |= IsKeyPressed(KEY_R);
+
+        accumulator += min(GetFrameTime(), MAX_FRAME_TIME);
+        while (accumulator >= SIM_STEP) {
+            sim.Step(SIM_STEP, pendingInput);
+            pendingInput = SimInput();  // Les commandes ne s'appliquent qu'une fois
+            accumulator -= SIM_STEP;
+        }
+        float alpha = accumulator / SIM_STEP;
+        float playerX = Game::Interpolate(sim.previousPosition.x, sim.player.x, alpha);
+        float playerY = Game::Interpolate(sim.previousPosition.y, sim.player.y, alpha);
 
-    // Si le jeu est en pause, afficher l'écran de pause
-    if (isPaused) {
         BeginDrawing();
         ClearBackground(Color{240, 220, 190, 255});
-        DrawTexture(resumeTexture, pauseButton.x, pauseButton.y, WHITE);  // Afficher l'icône de reprise
-        DrawText("Game Paused", SCREEN_WIDTH / 2 - MeasureText("Game Paused", 30) / 2, SCREEN_HEIGHT / 2 - 20, 30, BLACK);  // Afficher le texte "Game Paused"
+        view.Follow(playerX, playerY);
+        view.BeginWorld();
+        mazeRenderer.DrawEndless(sim.maze, view);
+        Game::DrawInCell(playerTexture, playerX, playerY, view);
+        view.EndWorld();
+
+        DrawText(TextFormat("%02d:%02d   distance %d", (int)sim.timer / 60, (int)sim.timer % 60, sim.farthest), 10, 10, 20, RED);
+        DrawText(TextFormat("blocs en mémoire %d/%d, générés %lld (P : pause, R : recommencer)",
+                            sim.maze.GetLoadedCount(), sim.maze.GetCapacity(), sim.maze.GetGeneratedCount()), 10, 35, 10, DARKGRAY);
+        if (sim.isPaused) {
+            DrawText("Game Paused", SCREEN_WIDTH / 2 - MeasureText("Game Paused", 30) / 2, SCREEN_HEIGHT / 2 - 20, 30, BLACK);
+        }
         EndDrawing();
-        return false;  // Ne pas mettre à jour le jeu si en pause
     }
+};
 
-    // Dessiner les boutons de contrôle
-    BeginDrawing();
-    ClearBackground(Color{240, 220, 190, 255});
-    DrawTexture(pauseTexture, pauseButton.x, pauseButton.y, WHITE);  // Afficher le bouton pause
-
-    if (!gameWon) {
-        // Afficher les boutons Reset et Home
-        DrawTexturePro(resetButtonTexture, {0, 0, (float)resetButtonTexture.width, (float)resetButtonTexture.height},
-            {resetButton.x, resetButton.y, resetButton.width, resetButton.height}, {0, 0}, 0.0f, WHITE);
-
-        DrawTexturePro(homeButtonTexture, {0, 0, (float)homeButtonTexture.width, (float)homeButtonTexture.height},
-            {homeButton.x, homeButton.y, homeButton.width, homeButton.height}, {0, 0}, 0.0f, WHITE);
-
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-            Vector2 mousePoint = GetMousePosition();
-            if (CheckCollisionPointRec(mousePoint, resetButton)) {
-                ResetGame();  // Réinitialiser le jeu
-            }
-            if (CheckCollisionPointRec(mousePoint, homeButton)) {
-                GoToIntroScreen();  // Réinitialiser tout et afficher l'écran d'accueil
-            }
+int main(int argc, char* argv[]) {
+    // Mode sans fin : game endless [graine]
+    bool endless = argc > 1 && string(argv[1]) == "endless";
+
+    // Labyrinthe d'un paquet de niveaux : game paquet.mzp [index] (paquets construits par maze_pack)
+    string firstArgument = argc > 1 ? argv[1] : "";
+    bool fromPack = firstArgument.size() > 4 && firstArgument.compare(firstArgument.size() - 4, 4, ".mzp") == 0;
+    MazePack pack;
+    MazeGrid packGrid;
+    MazeId packId = {};
+    if (fromPack) {
+        int index = argc > 2 ? atoi(argv[2]) : 0;
+        if (!pack.Open(argv[1])) {
+            fprintf(stderr, "%s : paquet illisible\n", argv[1]);
+            return 1;
+        }
+        MazeRecord record = pack.Get(index);
+        if (!record.IsValid() || !record.Decode(packGrid)) {
+            fprintf(stderr, "%s : labyrinthe %d absent ou abîmé (%d labyrinthes)\n", argv[1], index, pack.GetCount());
+            return 1;
         }
+        packId = record.GetId();
+        pack.Close();  // Les murs ont été recopiés dans packGrid
     }
 
-    // Afficher le texte du temps à côté de l'icône
-    DrawText(timeText, centerX, posY, fontSize, RED);
-    EndDrawing();
-    return false;
-}
-};
-int main() {
-    // Initialiser la fenêtre du jeu avec les dimensions spécifiées
+    // Taille du labyrinthe, éventuellement passée en argument sous la forme LARGEURxHAUTEUR (ex. : game 1000x1000)
+    int gridWidth = GRID_WIDTH;
+    int gridHeight = GRID_HEIGHT;
+    if (fromPack) {
+        gridWidth = packId.width;
+        gridHeight = packId.height;
+    } else if (argc > 1 && !endless && (sscanf(argv[1], "%dx%d", &gridWidth, &gridHeight) != 2 || gridWidth < 1 || gridHeight < 1)) {
+        gridWidth = GRID_WIDTH;
+        gridHeight = GRID_HEIGHT;
+    }
+
+    // Graine de la première partie, éventuellement passée en argument (ex. : game 20x15 0x2a) pour rejouer
+    // un labyrinthe journalisé ; sinon tirée de l'horloge
+    bool fixedSeed = argc > 2 && !fromPack;
+    uint64_t seed = fixedSeed ? strtoull(argv[2], NULL, 0) : Rng::SeedFromClock();
+
+    // Initialiser la fenêtre du jeu avec les dimensions spécifiées.
+    // L'affichage suit la synchronisation verticale au lieu d'une limite fixe : la simulation avance
+    // de toute façon par pas fixes (SIM_STEP), quelle que soit la fréquence d'affichage.
+    SetConfigFlags(FLAG_VSYNC_HINT);
     InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Maze Game");
 
+    // Décoder toutes les images et lire la musique sur des threads de travail pendant l'écran d'accueil :
+    // à la création de la partie, il ne reste que l'envoi des textures à la carte graphique
+    vector<const char*> images = {"img2.png", "img4.png", "brick.png"};
+    images.insert(images.end(), begin(ATLAS_SPRITES), end(ATLAS_SPRITES));
+    Assets().Preload(images, {INTRO_MUSIC});
+    Scores().Load(LEADERBOARD_FILE);  // Lu sur le pool lui aussi
+
     // Afficher l'écran d'introduction (par exemple, un écran d'accueil ou de présentation)
     ShowIntroScreen();
+    TraceLog(LOG_INFO, "SCORES: %d victoires chargées", (int)Scores().GetScores().size());
+    if (Scores().GetSkippedBytes() > 0) {
+        TraceLog(LOG_WARNING, "SCORES: %ld octets abîmés ignorés dans %s", Scores().GetSkippedBytes(), LEADERBOARD_FILE);
+    }
+
+    if (endless) {
+        EndlessGame game(seed);
+        while (!WindowShouldClose()) game.Update();
+    }
 
     // Boucle principale du jeu
-    while (true) {
+    while (!endless) {
         // Afficher le menu des niveaux et récupérer le niveau sélectionné
         Niveau::Level level = ShowLevelMenu();
 
-        // Créer un objet de jeu en fonction du niveau sélectionné
-        Game game(level);
+        // Créer un objet de jeu en fonction du niveau et de la taille de labyrinthe sélectionnés
+        Game game(level, gridWidth, gridHeight, seed);
+        if (fromPack) game.LoadFixedMaze(packId, packGrid);  // Murs du paquet à la place du labyrinthe généré
         game.Initialize();  // Initialiser le jeu (par exemple, charger les ressources, etc.)
-
-        // Définir la fréquence de mise à jour de l'écran (ici, 60 FPS)
-        SetTargetFPS(60);
+        if (!fixedSeed) seed = Rng::SeedFromClock();  // Nouvelle partie, nouveau labyrinthe
 
         bool retry = false;  // Variable pour vérifier si l'utilisateur veut réessayer le jeu
         do {
@@ -908,6 +749,14 @@ int main() {
     // Fermer le périphérique audio après la fin du jeu
     CloseAudioDevice();
 
+    // Attendre l'écriture des derniers scores
+    Scores().Flush();
+
+    // Libérer les textures encore en cache tant que le contexte graphique existe
+    // (le bouton Quit de l'écran de victoire a déjà fermé la fenêtre)
+    TraceLog(LOG_INFO, "ASSETS: %d fichiers image lus pendant la session", Assets().GetLoadCount());
+    if (IsWindowReady()) Assets().UnloadAll();
+
     // Fermer la fenêtre du jeu
     CloseWindow();
     return 0;  // Terminer l'exécution du programme
@@ -0,0 +1,242 @@
+// Évaluation en masse des labyrinthes : génère et fait résoudre un grand nombre de labyrinthes pour chaque
+// niveau et chaque algorithme de génération, sur tous les cœurs, et écrit les distributions dans un CSV.
+//
+// Pour chaque labyrinthe : longueur de la solution, impasses, facteur de branchement (choix moyens le long
+// de la solution) et temps de résolution d'un robot qui suit le mur de droite dans une vraie partie
+// (Simulation, avec les obstacles et les régénérations du niveau). Le robot fait BOT_MOVES_PER_SECOND
+// déplacements par seconde de jeu et abandonne après 4 déplacements par cellule.
+// Par défaut, les labyrinthes sont évalués tels que le générateur les produit (mode brut). En mode mise-au-point,
+// chaque labyrinthe est d'abord mis au point vers la difficulté visée du niveau (difficulty.h), comme en jeu :
+// les distributions montrent alors les labyrinthes tels que le joueur les rencontre, et donc surtout les cibles.
+//
+// Le labyrinthe n de chaque combinaison a la graine graine + n : les niveaux et les algorithmes sont comparés
+// sur les mêmes graines, et le résultat ne dépend pas du nombre de threads.
+// Les lots sont des travaux d'un pool à vol de travail (job_system.h) ; l'activité de chaque thread est affichée à la fin.
+// Compilé sans raylib : make eval && ./maze_eval [labyrinthes] [LARGEURxHAUTEUR] [threads] [fichier.csv] [graine]
+//                                 [brut|mise-au-point]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "job_system.h"
+#include "simulation.h"
+#include "maze_stats.h"
+
+using namespace std;
+
+static const int BOT_MOVES_PER_SECOND = 8;  // Vitesse du robot (un déplacement par appui, comme un joueur rapide)
+static const int LEVEL_COUNT = Niveau::DIFFICILE + 1;
+static const int BATCH = 64;                 // Labyrinthes pris à la fois par un thread
+
+// Mesures relevées sur chaque labyrinthe ; les valeurs sont entières (le facteur de branchement est en millièmes)
+enum Metric { SOLUTION_LENGTH, DEAD_ENDS, BRANCHING, BOT_SECONDS, BOT_TIMEOUT, METRIC_COUNT };
+static const char* const METRIC_NAMES[METRIC_COUNT] = {"solution_length", "dead_ends", "branching_factor", "bot_seconds", "bot_timeout"};
+static const double METRIC_SCALE[METRIC_COUNT] = {1, 1, 1000, BOT_MOVES_PER_SECOND, 1};
+
+// Distribution d'une mesure : histogramme à classes de largeur fixe (au plus BINS classes), somme exacte,
+// minimum et maximum. Deux histogrammes se fusionnent par addition, quel que soit l'ordre des labyrinthes.
+class Histogram {
+private:
+    static const int BINS = 4096;
+    long long binWidth;
+    std::vector<long long> counts;
+    long long count, sum, low, high;
+
+public:
+    // maxValue : plus grande valeur possible de la mesure
+    explicit Histogram(long long maxValue = 0)
+        : binWidth(maxValue / BINS + 1), counts(BINS, 0), count(0), sum(0), low(0), high(0) {}
+
+    void Add(long long value) {
+        counts[std::min<long long>(value / binWidth, BINS - 1)]++;
+        if (count == 0 || value < low) low = value;
+        if (count == 0 || value > high) high = value;
+        count++;
+        sum += value;
+    }
+
+    void Merge(const Histogram& other) {
+        if (other.count == 0) return;
+        for (int i = 0; i < BINS; i++) counts[i] += other.counts[i];
+        low = count ? std::min(low, other.low) : other.low;
+        high = count ? std::max(high, other.high) : other.high;
+        count += other.count;
+        sum += other.sum;
+    }
+
+    // Plus petite valeur v telle qu'au moins la fraction q des valeurs soit <= v (exacte si binWidth vaut 1)
+    long long Percentile(double q) const {
+        long long rank = (long long)(q * count);
+        long long seen = 0;
+        for (int i = 0; i < BINS; i++) {
+            seen += counts[i];
+            if (seen > rank) return std::min(std::max(i * binWidth, low), high);
+        }
+        return high;
+    }
+
+    long long GetCount() const { return count; }
+    double GetMean() const { return count ? (double)sum / count : 0.0; }
+    long long GetMin() const { return low; }
+    long long GetMax() const { return high; }
+};
+
+// Mesures d'une combinaison niveau x algorithme
+struct Distribution {
+    Histogram metrics[METRIC_COUNT];
+};
+
+// Robot qui suit le mur de droite : à chaque déplacement, essaie à droite, tout droit, à gauche puis demi-tour.
+// Dans un labyrinthe parfait, il atteint toujours la sortie (en au plus deux passages par couloir).
+// Renvoie le nombre de déplacements, ou -1 s'il n'a pas atteint la sortie avant maxMoves.
+static long long SolveWithBot(Simulation& sim, long long maxMoves) {
+    const int dx[4] = {0, 1, 0, -1};  // Indices de MazeGrid::Direction
+    const int dy[4] = {-1, 0, 1, 0};
+    const float dt = 1.0f / BOT_MOVES_PER_SECOND;
+    int heading = MazeGrid::RIGHT;
+    for (long long moves = 0; moves < maxMoves; moves++) {
+        Position from = sim.player.position;
+        int direction = -1;
+        for (int turn : {1, 0, 3, 2}) {
+            int d = (heading + turn) & 3;
+            if (!sim.maze.HasWall(from, dx[d], dy[d])) {
+                direction = d;
+                break;
+            }
+        }
+        if (direction < 0) return -1;  // Cellule fermée de tous côtés
+
+        SimInput input;
+        input.up = direction == MazeGrid::UP;
+        input.right = direction == MazeGrid::RIGHT;
+        input.down = direction == MazeGrid::DOWN;
+        input.left = direction == MazeGrid::LEFT;
+        sim.Step(dt, input);
+        if (sim.gameWon) return moves + 1;
+
+        Position to = sim.player.position;
+        if (to.x == from.x + dx[direction] && to.y == from.y + dy[direction]) heading = direction;
+        else if (to.x == 0 && to.y == 0) heading = MazeGrid::RIGHT;  // Renvoyé au départ par un obstacle
+    }
+    return -1;
+}
+
+// Évalue le labyrinthe index de la combinaison (level, algorithm) et ajoute ses mesures à la distribution
+static void Evaluate(Distribution& distribution, int level, int algorithm, long long index, int width, int height, uint64_t seed,
+                     bool tuned) {
+    Simulation sim((Niveau::Level)level, width, height, seed + index, (MazeAlgorithm)algorithm, tuned);
+    sim.asyncRegeneration = false;  // Le temps simulé avance bien plus vite que le temps réel
+    sim.Initialize();
+
+    MazeStats stats = ComputeMazeStats(sim.maze.GetGrid());
+    distribution.metrics[SOLUTION_LENGTH].Add(stats.solutionLength);
+    distribution.metrics[DEAD_ENDS].Add(stats.deadEnds);
+    distribution.metrics[BRANCHING].Add((long long)(stats.branchingFactor * METRIC_SCALE[BRANCHING] + 0.5));
+
+    long long moves = SolveWithBot(sim, 4LL * width * height);
+    distribution.metrics[BOT_TIMEOUT].Add(moves < 0);
+    if (moves >= 0) distribution.metrics[BOT_SECONDS].Add(moves);
+}
+
+int main(int argc, char* argv[]) {
+    long long mazes = 1000;              // Labyrinthes par combinaison niveau x algorithme
+    int width = 20, height = 15;         // Taille du labyrinthe du jeu
+    int threads = 0;                     // 0 : un thread par cœur
+    const char* path = "maze_eval.csv";  // Fichier de sortie
+    unsigned long long seed = 1234;      // Graine du premier labyrinthe de chaque combinaison
+    bool tuned = false;                  // Mise au point vers la difficulté du niveau
+
+    if (argc > 1) mazes = atoll(argv[1]);
+    if (argc > 2) sscanf(argv[2], "%dx%d", &width, &height);
+    if (argc > 3) threads = atoi(argv[3]);
+    if (argc > 4) path = argv[4];
+    if (argc > 5) seed = strtoull(argv[5], NULL, 0);
+    if (argc > 6) tuned = strcmp(argv[6], "mise-au-point") == 0;
+    if (mazes < 1 || width < 2 || height < 2 || (argc > 6 && !tuned && strcmp(argv[6], "brut") != 0)) {
+        fprintf(stderr, "usage: %s [labyrinthes] [LARGEURxHAUTEUR] [threads] [fichier.csv] [graine] [brut|mise-au-point]\n", argv[0]);
+        return 1;
+    }
+    if (threads <= 0) threads = max(1, (int)thread::hardware_concurrency());
+
+    // Plus grande valeur de chaque mesure, pour dimensionner les histogrammes
+    long long cells = (long long)width * height;
+    const long long maxValues[METRIC_COUNT] = {cells, cells, 3 * (long long)METRIC_SCALE[BRANCHING], 4 * cells, 1};
+    const int combinations = LEVEL_COUNT * ALGORITHM_COUNT;
+    auto makeDistributions = [&]() {
+        vector<Distribution> distributions(combinations);
+        for (Distribution& distribution : distributions) {
+            for (int m = 0; m < METRIC_COUNT; m++) distribution.metrics[m] = Histogram(maxValues[m]);
+        }
+        return distributions;
+    };
+
+    // Un travail par thread : chacun prend des lots de BATCH labyrinthes et remplit ses propres distributions,
+    // fusionnées à la fin. Le thread principal travaille aussi en attendant la fin des travaux.
+    JobSystem pool(max(1, threads - 1));
+    vector<vector<Distribution>> perJob(threads);
+    long long batchesPerCombination = (mazes + BATCH - 1) / BATCH;
+    long long totalBatches = batchesPerCombination * combinations;
+    atomic<long long> nextBatch(0);
+    auto start = chrono::steady_clock::now();
+    JobFence fence;
+    for (int t = 0; t < threads; t++) {
+        pool.Submit(fence, [&, t]() {
+            perJob[t] = makeDistributions();
+            for (long long batch = nextBatch++; batch < totalBatches; batch = nextBatch++) {
+                int combination = (int)(batch / batchesPerCombination);
+                long long first = (batch % batchesPerCombination) * BATCH;
+                long long last = min(first + BATCH, mazes);
+                for (long long index = first; index < last; index++) {
+                    Evaluate(perJob[t][combination], combination / ALGORITHM_COUNT, combination % ALGORITHM_COUNT,
+                             index, width, height, seed, tuned);
+                }
+            }
+        });
+    }
+    pool.Wait(fence);
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    vector<Distribution> results = makeDistributions();
+    for (const vector<Distribution>& distributions : perJob) {
+        for (int c = 0; c < combinations; c++) {
+            for (int m = 0; m < METRIC_COUNT; m++) results[c].metrics[m].Merge(distributions[c].metrics[m]);
+        }
+    }
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        fprintf(stderr, "impossible d'écrire %s\n", path);
+        return 1;
+    }
+    const char* levelNames[LEVEL_COUNT] = {"facile", "moyen", "difficile"};
+    fprintf(file, "level,algorithm,grid,metric,count,mean,min,p10,p50,p90,p99,max\n");
+    for (int c = 0; c < combinations; c++) {
+        for (int m = 0; m < METRIC_COUNT; m++) {
+            const Histogram& histogram = results[c].metrics[m];
+            double scale = METRIC_SCALE[m];
+            fprintf(file, "%s,%s,%dx%d,%s,%lld,%.4f,%.4g,%.4g,%.4g,%.4g,%.4g,%.4g\n",
+                    levelNames[c / ALGORITHM_COUNT], MazeAlgorithmName((MazeAlgorithm)(c % ALGORITHM_COUNT)), width, height,
+                    METRIC_NAMES[m], histogram.GetCount(), histogram.GetMean() / scale, histogram.GetMin() / scale,
+                    histogram.Percentile(0.10) / scale, histogram.Percentile(0.50) / scale, histogram.Percentile(0.90) / scale,
+                    histogram.Percentile(0.99) / scale, histogram.GetMax() / scale);
+        }
+    }
+    fclose(file);
+
+    long long total = mazes * combinations;
+    printf("%lld labyrinthes %dx%d %s (%d niveaux x %d algorithmes) en %.2f s sur %d threads : %.0f labyrinthes/s\n",
+           total, width, height, tuned ? "mis au point" : "bruts", LEVEL_COUNT, (int)ALGORITHM_COUNT, elapsed, threads,
+           total / elapsed);
+    for (int w = 0; w <= pool.GetWorkerCount(); w++) {
+        JobWorkerStats stats = pool.GetStats(w);
+        if (w < pool.GetWorkerCount()) printf("  thread %-9d", w);
+        else printf("  %-16s", "thread principal");
+        printf(" %6lld travaux %6lld vols %10.1f ms occupé %5.1f %%\n", stats.jobs, stats.steals, stats.busyMs, stats.utilisation * 100);
+    }
+    printf("distributions écrites dans %s\n", path);
+    return 0;
+}
@@ -0,0 +1,381 @@
+#ifndef MAZE_FILE_H
+#define MAZE_FILE_H
+
+// Format binaire des labyrinthes et paquets de niveaux.
+//
+// Un paquet (.mzp) contient de un à plusieurs milliers de labyrinthes. Il est lu par projection en mémoire
+// (mmap, ou CreateFileMapping sous Windows) : ouvrir le paquet ne lit que son en-tête, et le labyrinthe n
+// est trouvé en O(1) par la table d'index, sans analyse ni copie. Un fichier de labyrinthe seul
+// (SaveMazeFile / LoadMazeFile) est un paquet d'un labyrinthe.
+//
+// Disposition (petit-boutiste, chaque bloc aligné sur 8 octets) :
+//   MazePackHeader                      en-tête du paquet (32 octets)
+//   uint64_t offsets[count]             position de chaque labyrinthe dans le fichier
+//   MazeRecordHeader + murs, count fois identifiant, métadonnées, puis 2 bits par cellule
+//
+// Murs : cellules rangées ligne par ligne, 4 cellules par octet, en commençant par les bits de poids faible.
+// Le bit 0 d'une cellule est son mur du haut, le bit 1 son mur de gauche ; les murs de droite et du bas
+// sont ceux de ses voisines. Le bord droit et le bord du bas du labyrinthe sont toujours fermés.
+//
+// La version est vérifiée à l'ouverture : un lecteur refuse un paquet d'une version qu'il ne connaît pas.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include "maze_grid.h"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOGDI   // Évite les conflits de noms avec raylib (Rectangle, CloseWindow, ShowCursor...)
+    #define NOUSER
+    #include <windows.h>
+    #include <io.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+static const char MAZE_PACK_MAGIC[4] = {'M', 'Z', 'P', 'K'};
+static const uint16_t MAZE_PACK_VERSION = 1;
+
+// En-tête d'un paquet
+struct MazePackHeader {
+    char magic[4];       // "MZPK"
+    uint16_t version;    // MAZE_PACK_VERSION
+    uint16_t headerSize; // sizeof(MazePackHeader)
+    uint32_t count;      // Nombre de labyrinthes
+    uint32_t reserved;
+    uint64_t indexOffset; // Position de la table d'index
+    uint64_t fileSize;    // Taille totale du fichier (détecte un fichier tronqué)
+};
+
+// En-tête d'un labyrinthe du paquet, suivi de ses murs
+struct MazeRecordHeader {
+    uint64_t seed;           // Identifiant du labyrinthe (avec la taille et l'algorithme)
+    uint64_t checksum;       // MazeGrid::Checksum() des murs
+    uint32_t width, height;
+    uint32_t algorithm;      // MazeAlgorithm
+    int32_t level;           // Niveau de difficulté visé à la génération, -1 si aucun
+    int32_t solutionLength;  // Déplacements du départ à l'arrivée
+    int32_t deadEnds;        // Nombre d'impasses
+    uint32_t wallBytes;      // Taille des murs qui suivent (en octets)
+    uint32_t reserved;
+    char name[16];           // Nom libre (campagnes), terminé par un zéro
+};
+
+static_assert(sizeof(MazePackHeader) == 32 && sizeof(MazeRecordHeader) == 64, "en-têtes du format sur disque");
+
+// Métadonnées enregistrées avec un labyrinthe
+struct MazeInfo {
+    MazeId id;
+    int level;           // -1 si aucun
+    int solutionLength;
+    int deadEnds;
+    std::string name;
+};
+
+// Labyrinthe lu dans un paquet projeté en mémoire : les murs sont lus directement dans le fichier
+class MazeRecord {
+private:
+    const MazeRecordHeader* header;
+    const uint8_t* walls;
+
+    // Deux bits de la cellule (x, y) : bit 0 mur du haut, bit 1 mur de gauche
+    int Cell(int x, int y) const {
+        size_t index = (size_t)y * header->width + x;
+        return (walls[index >> 2] >> ((index & 3) * 2)) & 3;
+    }
+
+public:
+    MazeRecord(const MazeRecordHeader* recordHeader = nullptr)
+        : header(recordHeader), walls(recordHeader ? (const uint8_t*)(recordHeader + 1) : nullptr) {}
+
+    bool IsValid() const { return header != nullptr; }
+
+    MazeId GetId() const {
+        return MazeId{header->seed, (int)header->width, (int)header->height, (MazeAlgorithm)header->algorithm};
+    }
+
+    MazeInfo GetInfo() const {
+        return MazeInfo{GetId(), header->level, header->solutionLength, header->deadEnds,
+                        std::string(header->name, strnlen(header->name, sizeof(header->name)))};
+    }
+
+    uint64_t GetChecksum() const { return header->checksum; }
+
+    // Même convention que MazeGrid::HasWall, sans décodage préalable
+    bool HasWall(int x, int y, int dx, int dy) const {
+        if (dx == -1) return Cell(x, y) & 2;
+        if (dx == 1) return x + 1 == (int)header->width || (Cell(x + 1, y) & 2);
+        if (dy == -1) return Cell(x, y) & 1;
+        if (dy == 1) return y + 1 == (int)header->height || (Cell(x, y + 1) & 1);
+        return false;
+    }
+
+    // Recopie les murs dans grid (redimensionnée si besoin).
+    // Renvoie false si l'empreinte ne correspond pas (fichier abîmé).
+    bool Decode(MazeGrid& grid) const {
+        int width = header->width, height = header->height;
+        if (grid.GetWidth() != width || grid.GetHeight() != height) grid.Resize(width, height);
+        else grid.Reset();
+        size_t index = 0;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++, index++) {
+                int cell = (walls[index >> 2] >> ((index & 3) * 2)) & 3;
+                if (!(cell & 1)) grid.RemoveWall(x, y, MazeGrid::UP);
+                if (!(cell & 2)) grid.RemoveWall(x, y, MazeGrid::LEFT);
+            }
+        }
+        return grid.Checksum() == header->checksum;
+    }
+};
+
+// Fichier projeté en lecture seule
+class MappedFile {
+private:
+    const uint8_t* data;
+    size_t size;
+#if defined(_WIN32)
+    HANDLE file, mapping;
+#endif
+
+public:
+    MappedFile() : data(nullptr), size(0) {
+#if defined(_WIN32)
+        file = INVALID_HANDLE_VALUE;
+        mapping = NULL;
+#endif
+    }
+    ~MappedFile() { Close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const char* path) {
+        Close();
+#if defined(_WIN32)
+        file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            Close();
+            return false;
+        }
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!data) {
+            Close();
+            return false;
+        }
+        size = (size_t)fileSize.QuadPart;
+#else
+        int fd = open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size == 0) {
+            close(fd);
+            return false;
+        }
+        void* mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);  // La projection reste valide après la fermeture du descripteur
+        if (mapped == MAP_FAILED) return false;
+        data = (const uint8_t*)mapped;
+        size = (size_t)info.st_size;
+#endif
+        return true;
+    }
+
+    void Close() {
+#if defined(_WIN32)
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        file = INVALID_HANDLE_VALUE;
+        mapping = NULL;
+#else
+        if (data) munmap((void*)data, size);
+#endif
+        data = nullptr;
+        size = 0;
+    }
+
+    const uint8_t* GetData() const { return data; }
+    size_t GetSize() const { return size; }
+};
+
+// Paquet de labyrinthes ouvert en lecture. Seul l'en-tête est vérifié à l'ouverture ;
+// chaque labyrinthe est vérifié (bornes et taille des murs) quand on le demande.
+class MazePack {
+private:
+    MappedFile file;
+    const MazePackHeader* header;
+    const uint64_t* offsets;
+
+public:
+    MazePack() : header(nullptr), offsets(nullptr) {}
+
+    // Renvoie false si le fichier n'existe pas, n'est pas un paquet, est d'une autre version ou est tronqué
+    bool Open(const char* path) {
+        header = nullptr;
+        offsets = nullptr;
+        if (!file.Open(path)) return false;
+        const uint8_t* data = file.GetData();
+        size_t size = file.GetSize();
+        if (size < sizeof(MazePackHeader)) return false;
+        const MazePackHeader* candidate = (const MazePackHeader*)data;
+        if (memcmp(candidate->magic, MAZE_PACK_MAGIC, 4) != 0 || candidate->version != MAZE_PACK_VERSION ||
+            candidate->headerSize != sizeof(MazePackHeader) || candidate->fileSize != size ||
+            candidate->indexOffset % 8 != 0 || candidate->indexOffset > size ||
+            (size - candidate->indexOffset) / sizeof(uint64_t) < candidate->count) {
+            file.Close();
+            return false;
+        }
+        header = candidate;
+        offsets = (const uint64_t*)(data + header->indexOffset);
+        return true;
+    }
+
+    void Close() {
+        file.Close();
+        header = nullptr;
+        offsets = nullptr;
+    }
+
+    bool IsOpen() const { return header != nullptr; }
+    int GetCount() const { return header ? (int)header->count : 0; }
+    size_t GetFileSize() const { return file.GetSize(); }
+
+    // Labyrinthe index du paquet, en O(1) ; invalide si l'index est hors limites ou l'entrée abîmée
+    MazeRecord Get(int index) const {
+        if (!header || index < 0 || index >= (int)header->count) return MazeRecord();
+        uint64_t offset = offsets[index];
+        size_t size = file.GetSize();
+        if (offset % 8 != 0 || offset > size || size - offset < sizeof(MazeRecordHeader)) return MazeRecord();
+        const MazeRecordHeader* record = (const MazeRecordHeader*)(file.GetData() + offset);
+        uint64_t cells = (uint64_t)record->width * record->height;
+        if (record->width == 0 || record->height == 0 || cells > 0x7FFFFFFF || record->algorithm >= ALGORITHM_COUNT ||
+            record->wallBytes != (cells + 3) / 4 || size - offset - sizeof(MazeRecordHeader) < record->wallBytes) {
+            return MazeRecord();
+        }
+        return MazeRecord(record);
+    }
+};
+
+// Construction d'un paquet en mémoire, écrit en une fois par Write()
+class MazePackWriter {
+private:
+    std::vector<std::vector<uint8_t>> records;  // En-tête et murs de chaque labyrinthe, complétés à 8 octets
+
+public:
+    // Ajoute un labyrinthe ; renvoie false si son bord droit ou son bord du bas est ouvert (non représentable)
+    bool Add(const MazeGrid& grid, const MazeInfo& info) {
+        int width = grid.GetWidth(), height = grid.GetHeight();
+        for (int y = 0; y < height; y++) {
+            if (!grid.HasVerticalWall(width, y)) return false;
+        }
+        for (int x = 0; x < width; x++) {
+            if (!grid.HasHorizontalWall(x, height)) return false;
+        }
+
+        MazeRecordHeader header;
+        memset(&header, 0, sizeof(header));
+        header.seed = info.id.seed;
+        header.checksum = grid.Checksum();
+        header.width = width;
+        header.height = height;
+        header.algorithm = info.id.algorithm;
+        header.level = info.level;
+        header.solutionLength = info.solutionLength;
+        header.deadEnds = info.deadEnds;
+        header.wallBytes = (uint32_t)(((size_t)width * height + 3) / 4);
+        strncpy(header.name, info.name.c_str(), sizeof(header.name) - 1);
+
+        std::vector<uint8_t> record(sizeof(header) + (header.wallBytes + 7) / 8 * 8, 0);
+        memcpy(record.data(), &header, sizeof(header));
+        uint8_t* walls = record.data() + sizeof(header);
+        size_t index = 0;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++, index++) {
+                int cell = grid.HasHorizontalWall(x, y) | (grid.HasVerticalWall(x, y) << 1);
+                walls[index >> 2] |= (uint8_t)(cell << ((index & 3) * 2));
+            }
+        }
+        records.push_back(std::move(record));
+        return true;
+    }
+
+    int GetCount() const { return (int)records.size(); }
+
+    // Écrit le paquet dans un fichier temporaire renommé à la fin : un paquet existant n'est jamais laissé à moitié écrit
+    bool Write(const char* path) const {
+        MazePackHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAZE_PACK_MAGIC, 4);
+        header.version = MAZE_PACK_VERSION;
+        header.headerSize = sizeof(MazePackHeader);
+        header.count = (uint32_t)records.size();
+        header.indexOffset = sizeof(MazePackHeader);
+
+        std::vector<uint64_t> offsets(records.size());
+        uint64_t offset = header.indexOffset + offsets.size() * sizeof(uint64_t);
+        for (size_t i = 0; i < records.size(); i++) {
+            offsets[i] = offset;
+            offset += records[i].size();
+        }
+        header.fileSize = offset;
+
+        std::string temporary = std::string(path) + ".tmp";
+        FILE* file = fopen(temporary.c_str(), "wb");
+        if (!file) return false;
+        bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+        if (!offsets.empty()) ok = ok && fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), file) == offsets.size();
+        for (const std::vector<uint8_t>& record : records) ok = ok && fwrite(record.data(), 1, record.size(), file) == record.size();
+        // Données sur le disque avant le renommage : après une coupure, le paquet renommé n'est jamais vide
+        ok = ok && fflush(file) == 0;
+#if defined(_WIN32)
+        ok = ok && _commit(_fileno(file)) == 0;
+#else
+        ok = ok && fsync(fileno(file)) == 0;
+#endif
+        ok = fclose(file) == 0 && ok;
+        if (!ok) {
+            remove(temporary.c_str());
+            return false;
+        }
+#if defined(_WIN32)
+        // Remplacement en une seule opération (rename() ne remplace pas un fichier existant sous Windows)
+        if (!MoveFileExA(temporary.c_str(), path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+            remove(temporary.c_str());
+            return false;
+        }
+        return true;
+#else
+        if (rename(temporary.c_str(), path) != 0) {
+            remove(temporary.c_str());
+            return false;
+        }
+        return true;
+#endif
+    }
+};
+
+// Enregistre un labyrinthe seul (paquet d'un labyrinthe)
+inline bool SaveMazeFile(const char* path, const MazeGrid& grid, const MazeInfo& info) {
+    MazePackWriter writer;
+    return writer.Add(grid, info) && writer.Write(path);
+}
+
+// Lit un labyrinthe seul ; renvoie false si le fichier est absent, d'une autre version ou abîmé
+inline bool LoadMazeFile(const char* path, MazeGrid& grid, MazeInfo& info) {
+    MazePack pack;
+    if (!pack.Open(path)) return false;
+    MazeRecord record = pack.Get(0);
+    if (!record.IsValid() || !record.Decode(grid)) return false;
+    info = record.GetInfo();
+    return true;
+}
+
+#endif
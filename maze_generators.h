@@ -0,0 +1,386 @@
+#ifndef MAZE_GENERATORS_H
+#define MAZE_GENERATORS_H
+
+#include <stdint.h>
+#include <utility>
+#include <vector>
+#include "maze_grid.h"
+#include "rng.h"
+
+// Générateurs de labyrinthes parfaits (un seul chemin entre deux cellules quelconques).
+// Tous partent d'une grille où tous les murs sont présents et ne font qu'en retirer ;
+// le choix de l'algorithme change la forme du labyrinthe (longueur des couloirs, nombre d'impasses).
+// Les tampons de travail sont conservés d'une génération à l'autre pour éviter les réallocations :
+// un générateur ne doit être utilisé que par un thread à la fois.
+class MazeGenerator {
+private:
+    std::vector<uint32_t> edges;     // Arêtes candidates (Kruskal, Prim) : cellule * 2 + (0 = droite, 1 = bas)
+    std::vector<int> parent;         // Forêt d'union-find (Kruskal, Eller)
+    std::vector<int> cells;          // Cellules actives (arbre croissant)
+    std::vector<uint8_t> walk;       // Direction prise depuis chaque cellule par la marche aléatoire (Wilson)
+    std::vector<int> rowSets;        // Ensemble de chaque cellule de la rangée courante (Eller)
+    std::vector<int> setInfo;        // Compteurs par ensemble de la rangée courante (Eller)
+
+    // Racine de l'ensemble contenant i, avec compression de chemin par moitiés
+    int Find(int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    // Cellule voisine de (x, y) dans la direction donnée, ou false si elle sort de la grille
+    static bool Neighbor(const MazeGrid& grid, int x, int y, int direction, int& nx, int& ny) {
+        nx = x;
+        ny = y;
+        switch (direction) {
+            case MazeGrid::UP: ny--; break;
+            case MazeGrid::RIGHT: nx++; break;
+            case MazeGrid::DOWN: ny++; break;
+            case MazeGrid::LEFT: nx--; break;
+        }
+        return nx >= 0 && nx < grid.GetWidth() && ny >= 0 && ny < grid.GetHeight();
+    }
+
+    // Ouvre l'arête codée cellule * 2 + (0 = droite, 1 = bas)
+    static void OpenEdge(MazeGrid& grid, uint32_t edge) {
+        int cell = (int)(edge >> 1);
+        grid.RemoveWall(cell % grid.GetWidth(), cell / grid.GetWidth(), (edge & 1) ? MazeGrid::DOWN : MazeGrid::RIGHT);
+    }
+
+    // Kruskal : toutes les arêtes dans un ordre aléatoire, chacune ouverte si elle relie deux ensembles distincts
+    void GenerateKruskal(MazeGrid& grid, Rng& random) {
+        int width = grid.GetWidth();
+        int height = grid.GetHeight();
+        int count = width * height;
+
+        edges.clear();
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                uint32_t cell = (uint32_t)(y * width + x);
+                if (x + 1 < width) edges.push_back(cell * 2);
+                if (y + 1 < height) edges.push_back(cell * 2 + 1);
+            }
+        }
+        for (int i = (int)edges.size() - 1; i > 0; i--) {  // Mélange de Fisher-Yates
+            std::swap(edges[i], edges[random.Range(0, i)]);
+        }
+
+        parent.resize(count);
+        for (int i = 0; i < count; i++) parent[i] = i;
+
+        int joined = 0;
+        for (uint32_t edge : edges) {
+            int cell = (int)(edge >> 1);
+            int other = (edge & 1) ? cell + width : cell + 1;
+            int a = Find(cell), b = Find(other);
+            if (a == b) continue;  // Déjà reliées : ouvrir ce mur créerait une boucle
+            parent[a] = b;
+            OpenEdge(grid, edge);
+            if (++joined == count - 1) break;  // Arbre couvrant complet
+        }
+    }
+
+    // Prim : l'arbre grandit depuis la cellule de départ en ouvrant à chaque fois une arête aléatoire de sa frontière
+    void GeneratePrim(MazeGrid& grid, int startX, int startY, Rng& random) {
+        int width = grid.GetWidth();
+        edges.clear();
+
+        // Arêtes de la frontière codées cellule * 4 + direction, depuis une cellule déjà dans l'arbre
+        grid.SetVisited(startX, startY);
+        for (int direction = 0; direction < 4; direction++) edges.push_back((uint32_t)((startY * width + startX) * 4 + direction));
+
+        while (!edges.empty()) {
+            int pick = random.Range(0, (int)edges.size() - 1);
+            uint32_t edge = edges[pick];
+            edges[pick] = edges.back();  // Retrait en temps constant
+            edges.pop_back();
+
+            int cell = (int)(edge >> 2);
+            int direction = (int)(edge & 3);
+            int x = cell % width, y = cell / width, nx, ny;
+            if (!Neighbor(grid, x, y, direction, nx, ny) || grid.IsVisited(nx, ny)) continue;
+
+            grid.RemoveWall(x, y, direction);
+            grid.SetVisited(nx, ny);
+            for (int next = 0; next < 4; next++) edges.push_back((uint32_t)((ny * width + nx) * 4 + next));
+        }
+    }
+
+    // Wilson : marches aléatoires à boucles effacées jusqu'à l'arbre ; labyrinthe tiré uniformément parmi tous les arbres couvrants
+    void GenerateWilson(MazeGrid& grid, int startX, int startY, Rng& random) {
+        int width = grid.GetWidth();
+        int height = grid.GetHeight();
+        walk.assign((size_t)width * height, 0);
+        grid.SetVisited(startX, startY);
+
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if (grid.IsVisited(x, y)) continue;
+
+                // Marche aléatoire jusqu'à une cellule de l'arbre ; en revenant sur une cellule,
+                // la nouvelle direction écrase l'ancienne, ce qui efface la boucle
+                int cx = x, cy = y, nx, ny;
+                while (!grid.IsVisited(cx, cy)) {
+                    int direction;
+                    do {
+                        direction = random.Range(0, 3);
+                    } while (!Neighbor(grid, cx, cy, direction, nx, ny));
+                    walk[(size_t)cy * width + cx] = (uint8_t)direction;
+                    cx = nx;
+                    cy = ny;
+                }
+
+                // Ajoute à l'arbre le chemin sans boucle en suivant les directions retenues
+                cx = x;
+                cy = y;
+                while (!grid.IsVisited(cx, cy)) {
+                    int direction = walk[(size_t)cy * width + cx];
+                    grid.SetVisited(cx, cy);
+                    grid.RemoveWall(cx, cy, direction);
+                    Neighbor(grid, cx, cy, direction, nx, ny);
+                    cx = nx;
+                    cy = ny;
+                }
+            }
+        }
+    }
+
+    // Arbre croissant : comme le backtracker, mais la cellule prolongée est une fois sur deux la plus récente
+    // (longs couloirs) et une fois sur deux une cellule active au hasard (nombreuses ramifications)
+    void GenerateGrowingTree(MazeGrid& grid, int startX, int startY, Rng& random) {
+        int width = grid.GetWidth();
+        cells.clear();
+        cells.push_back(startY * width + startX);
+        grid.SetVisited(startX, startY);
+
+        while (!cells.empty()) {
+            int index = random.Range(0, 1) ? (int)cells.size() - 1 : random.Range(0, (int)cells.size() - 1);
+            int x = cells[index] % width;
+            int y = cells[index] / width;
+
+            // Première direction libre à partir d'une direction de départ aléatoire
+            int first = random.Range(0, 3);
+            bool moved = false;
+            for (int i = 0; i < 4 && !moved; i++) {
+                int direction = (first + i) & 3;
+                int nx, ny;
+                if (Neighbor(grid, x, y, direction, nx, ny) && !grid.IsVisited(nx, ny)) {
+                    grid.RemoveWall(x, y, direction);
+                    grid.SetVisited(nx, ny);
+                    cells.push_back(ny * width + nx);
+                    moved = true;
+                }
+            }
+            if (!moved) {  // Plus aucune voisine libre : la cellule n'est plus active
+                cells[index] = cells.back();
+                cells.pop_back();
+            }
+        }
+    }
+
+    // Eller : une rangée à la fois, avec des ensembles de cellules connectées limités à la rangée courante.
+    // La mémoire de travail est proportionnelle à la largeur, pas au nombre de cellules.
+    void GenerateEller(MazeGrid& grid, Rng& random) {
+        int width = grid.GetWidth();
+        int height = grid.GetHeight();
+        rowSets.assign(width, -1);
+        parent.resize(width);
+        setInfo.resize(width * 3);  // Par ensemble : nombre de cellules, cellule candidate, descente déjà ouverte
+        int* members = setInfo.data();
+        int* candidate = setInfo.data() + width;
+        int* descends = setInfo.data() + 2 * width;
+
+        for (int y = 0; y < height; y++) {
+            bool lastRow = y == height - 1;
+
+            // Les cellules sans ensemble (pas de passage depuis la rangée du dessus) en reçoivent un nouveau.
+            // Les ensembles sont renumérotés de 0 à width - 1 à chaque rangée.
+            for (int i = 0; i < width; i++) parent[i] = -1;
+            int labels = 0;
+            for (int x = 0; x < width; x++) {
+                if (rowSets[x] >= 0) {
+                    int old = rowSets[x];
+                    if (parent[old] < 0) parent[old] = labels++;  // parent sert ici de table de renumérotation
+                    rowSets[x] = parent[old];
+                }
+            }
+            for (int x = 0; x < width; x++) {
+                if (rowSets[x] < 0) rowSets[x] = labels++;
+            }
+            for (int i = 0; i < width; i++) parent[i] = i;
+
+            // Fusions horizontales aléatoires (toutes obligatoires sur la dernière rangée)
+            for (int x = 0; x + 1 < width; x++) {
+                int a = Find(rowSets[x]), b = Find(rowSets[x + 1]);
+                if (a != b && (lastRow || random.Range(0, 1))) {
+                    grid.RemoveWall(x, y, MazeGrid::RIGHT);
+                    parent[a] = b;
+                }
+            }
+            for (int x = 0; x < width; x++) rowSets[x] = Find(rowSets[x]);
+            if (lastRow) break;
+
+            // Descentes aléatoires, au moins une par ensemble (cellule candidate tirée uniformément par réservoir)
+            for (int i = 0; i < width; i++) members[i] = descends[i] = 0;
+            for (int x = 0; x < width; x++) {
+                int set = rowSets[x];
+                if (random.Range(0, members[set]) == 0) candidate[set] = x;
+                members[set]++;
+            }
+            for (int x = 0; x < width; x++) {
+                int set = rowSets[x];
+                if (random.Range(0, 1)) {
+                    grid.RemoveWall(x, y, MazeGrid::DOWN);
+                    descends[set] = 1;
+                } else {
+                    rowSets[x] = -1 - set;  // Provisoire : pas de descente pour l'instant
+                }
+            }
+            for (int x = 0; x < width; x++) {
+                if (rowSets[x] >= 0) continue;
+                int set = -1 - rowSets[x];
+                if (!descends[set] && candidate[set] == x) {
+                    grid.RemoveWall(x, y, MazeGrid::DOWN);  // Sinon l'ensemble serait coupé du reste
+                    rowSets[x] = set;
+                } else {
+                    rowSets[x] = -1;  // Nouvelle cellule isolée à la rangée suivante
+                }
+            }
+        }
+    }
+
+    // Passage ouvert entre la cellule locale cell (de la fenêtre [x0, x0 + w) x [y0, ...)) et sa voisine
+    // de droite (down = false) ou du dessous (down = true)
+    static bool IsOpen(const MazeGrid& grid, int x0, int y0, int w, int cell, bool down) {
+        int x = x0 + cell % w, y = y0 + cell / w;
+        return down ? !grid.HasHorizontalWall(x, y + 1) : !grid.HasVerticalWall(x + 1, y);
+    }
+
+public:
+    // Re-génère la fenêtre [x0, x1) x [y0, y1) d'un labyrinthe parfait sans lire ni modifier le reste de la grille :
+    // le coût est proportionnel à la taille de la fenêtre, pas à celle du labyrinthe.
+    //
+    // Les cellules de la fenêtre reliées entre elles par l'extérieur sont inconnues sans parcourir toute la grille.
+    // On garde donc, pour chaque morceau de la fenêtre, les seuls chemins qui relient ses ouvertures vers l'extérieur
+    // (et la cellule (pinX, pinY) si elle est dans la fenêtre) ; tout le reste est creusé à nouveau par Kruskal,
+    // sans jamais relier deux morceaux distincts. Les distances entre ouvertures sont conservées : hors de la fenêtre,
+    // le chemin vers la cellule (pinX, pinY) ne change pas.
+    void RegenerateRegion(MazeGrid& grid, int x0, int y0, int x1, int y1, Rng& random, int pinX = -1, int pinY = -1) {
+        int w = x1 - x0, h = y1 - y0, count = w * h;
+        if (w <= 0 || h <= 0) return;
+        const uint8_t TERMINAL = 1, PRUNED = 2;
+
+        // Ouvertures vers l'extérieur de la fenêtre et degré de chaque cellule dans la fenêtre
+        walk.assign(count, 0);
+        cells.assign(count, 0);
+        for (int ly = 0; ly < h; ly++) {
+            for (int lx = 0; lx < w; lx++) {
+                int cell = ly * w + lx, x = x0 + lx, y = y0 + ly;
+                if ((lx == 0 && x > 0 && !grid.HasVerticalWall(x, y)) ||
+                    (lx == w - 1 && x + 1 < grid.GetWidth() && !grid.HasVerticalWall(x + 1, y)) ||
+                    (ly == 0 && y > 0 && !grid.HasHorizontalWall(x, y)) ||
+                    (ly == h - 1 && y + 1 < grid.GetHeight() && !grid.HasHorizontalWall(x, y + 1)) ||
+                    (x == pinX && y == pinY)) {
+                    walk[cell] = TERMINAL;
+                }
+                if (lx + 1 < w && IsOpen(grid, x0, y0, w, cell, false)) { cells[cell]++; cells[cell + 1]++; }
+                if (ly + 1 < h && IsOpen(grid, x0, y0, w, cell, true)) { cells[cell]++; cells[cell + w]++; }
+            }
+        }
+
+        // Élagage des feuilles qui ne sont pas des ouvertures : il reste l'arbre minimal qui relie
+        // les ouvertures de chaque morceau (rowSets sert de file)
+        rowSets.clear();
+        for (int cell = 0; cell < count; cell++) {
+            if (!(walk[cell] & TERMINAL) && cells[cell] <= 1) rowSets.push_back(cell);
+        }
+        for (size_t head = 0; head < rowSets.size(); head++) {
+            int cell = rowSets[head];
+            walk[cell] |= PRUNED;
+            int lx = cell % w, ly = cell / w;
+            int neighbors[4] = {
+                lx + 1 < w && IsOpen(grid, x0, y0, w, cell, false) ? cell + 1 : -1,
+                ly + 1 < h && IsOpen(grid, x0, y0, w, cell, true) ? cell + w : -1,
+                lx > 0 && IsOpen(grid, x0, y0, w, cell - 1, false) ? cell - 1 : -1,
+                ly > 0 && IsOpen(grid, x0, y0, w, cell - w, true) ? cell - w : -1
+            };
+            for (int neighbor : neighbors) {
+                if (neighbor < 0 || (walk[neighbor] & PRUNED)) continue;
+                if (--cells[neighbor] == 1 && !(walk[neighbor] & TERMINAL)) rowSets.push_back(neighbor);
+            }
+        }
+
+        // Arêtes intérieures : celles de l'arbre minimal restent ouvertes, toutes les autres sont refermées
+        parent.resize(count);
+        setInfo.assign(count, 0);  // Par ensemble : 1 s'il contient des ouvertures (un morceau à ne pas relier à un autre)
+        for (int cell = 0; cell < count; cell++) parent[cell] = cell;
+        edges.clear();
+        for (int cell = 0; cell < count; cell++) {
+            int x = x0 + cell % w, y = y0 + cell / w;
+            for (int down = 0; down < 2; down++) {
+                int other = down ? cell + w : cell + 1;
+                if (down ? cell / w + 1 >= h : cell % w + 1 >= w) continue;
+                bool kept = IsOpen(grid, x0, y0, w, cell, down) && !(walk[cell] & PRUNED) && !(walk[other] & PRUNED);
+                if (kept) {
+                    parent[Find(cell)] = Find(other);
+                } else {
+                    grid.AddWall(x, y, down ? MazeGrid::DOWN : MazeGrid::RIGHT);
+                    edges.push_back((uint32_t)(cell * 2 + down));
+                }
+            }
+        }
+        for (int cell = 0; cell < count; cell++) {
+            if (walk[cell] & TERMINAL) setInfo[Find(cell)] = 1;
+        }
+
+        // Kruskal sur les arêtes refermées, sans créer de boucle ni relier deux morceaux porteurs d'ouvertures
+        for (int i = (int)edges.size() - 1; i > 0; i--) {
+            std::swap(edges[i], edges[random.Range(0, i)]);
+        }
+        for (uint32_t edge : edges) {
+            int cell = (int)(edge >> 1);
+            int other = (edge & 1) ? cell + w : cell + 1;
+            int a = Find(cell), b = Find(other);
+            if (a == b || (setInfo[a] && setInfo[b])) continue;
+            parent[a] = b;
+            setInfo[b] |= setInfo[a];
+            grid.RemoveWall(x0 + cell % w, y0 + cell / w, (edge & 1) ? MazeGrid::DOWN : MazeGrid::RIGHT);
+        }
+    }
+
+    // Génère dans grid le labyrinthe identifié par id, aux dimensions de l'identifiant, à partir de la cellule
+    // (startX, startY). Sans cellule de départ (startX < 0), elle est tirée de la graine. L'identifiant et la cellule
+    // de départ suffisent à reproduire les murs bit pour bit.
+    void Generate(MazeGrid& grid, const MazeId& id, int startX = -1, int startY = -1) {
+        if (id.width != grid.GetWidth() || id.height != grid.GetHeight()) grid.Resize(id.width, id.height);
+        else grid.Reset();
+
+        Rng random(id.seed);
+        int drawnX = random.Range(0, id.width - 1);  // Tirée dans tous les cas : la suite des tirages ne change pas
+        int drawnY = random.Range(0, id.height - 1);
+        if (startX < 0) {
+            startX = drawnX;
+            startY = drawnY;
+        }
+
+        switch (id.algorithm) {
+            case KRUSKAL: GenerateKruskal(grid, random); break;
+            case PRIM: GeneratePrim(grid, startX, startY, random); break;
+            case WILSON: GenerateWilson(grid, startX, startY, random); break;
+            case GROWING_TREE: GenerateGrowingTree(grid, startX, startY, random); break;
+            case ELLER: GenerateEller(grid, random); break;
+            case BACKTRACKER:
+            default: grid.GeneratePath(startX, startY, random); break;
+        }
+    }
+
+    // Mémoire réservée par les tampons de travail (en octets)
+    size_t ScratchBytes() const {
+        return edges.capacity() * sizeof(uint32_t) + parent.capacity() * sizeof(int) + cells.capacity() * sizeof(int) +
+               walk.capacity() + rowSets.capacity() * sizeof(int) + setInfo.capacity() * sizeof(int);
+    }
+};
+
+#endif
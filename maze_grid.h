@@ -0,0 +1,216 @@
+#ifndef MAZE_GRID_H
+#define MAZE_GRID_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "rng.h"
+
+// Algorithmes de génération disponibles (implémentés dans maze_generators.h)
+enum MazeAlgorithm { BACKTRACKER, KRUSKAL, PRIM, WILSON, GROWING_TREE, ELLER, ALGORITHM_COUNT };
+
+// Nom d'un algorithme de génération, utilisé dans les journaux et les identifiants
+inline const char* MazeAlgorithmName(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+        case BACKTRACKER: return "backtracker";
+        case KRUSKAL: return "kruskal";
+        case PRIM: return "prim";
+        case WILSON: return "wilson";
+        case GROWING_TREE: return "growing-tree";
+        case ELLER: return "eller";
+        case ALGORITHM_COUNT: break;
+    }
+    return "?";
+}
+
+// Identifiant complet d'un labyrinthe : la même graine, la même taille et le même algorithme
+// redonnent exactement les mêmes murs, ce qui permet de journaliser, partager et rejouer un labyrinthe
+struct MazeId {
+    uint64_t seed;            // Graine du générateur pseudo-aléatoire
+    int width, height;        // Dimensions (en cellules)
+    MazeAlgorithm algorithm;  // Algorithme de génération
+
+    // Forme texte, ex. : 20x15-backtracker-0123456789abcdef
+    void Format(char* buffer, size_t size) const {
+        snprintf(buffer, size, "%dx%d-%s-%016llx", width, height, MazeAlgorithmName(algorithm), (unsigned long long)seed);
+    }
+};
+
+// Grille de labyrinthe dont les dimensions sont choisies à l'exécution, indépendante de raylib.
+//
+// Chaque mur n'est stocké qu'une seule fois, sous forme de bit :
+//  - hWalls : murs horizontaux, (height + 1) lignes de width bits. Le bit (x, y) est le mur
+//    au-dessus de la cellule (x, y), donc aussi le mur en dessous de la cellule (x, y - 1).
+//  - vWalls : murs verticaux, height lignes de (width + 1) bits. Le bit (x, y) est le mur
+//    à gauche de la cellule (x, y), donc aussi le mur à droite de la cellule (x - 1, y).
+//  - visited : une ligne de width bits par rangée de cellules.
+// Chaque ligne commence sur un mot de 64 bits, ce qui permet de réinitialiser un plan mot par mot.
+class MazeGrid {
+private:
+    int width, height;              // Dimensions de la grille (en cellules)
+    size_t hStride, vStride;        // Nombre de mots de 64 bits par ligne des plans horizontaux et verticaux
+    std::vector<uint64_t> hWalls;   // Plan des murs horizontaux
+    std::vector<uint64_t> vWalls;   // Plan des murs verticaux
+    std::vector<uint64_t> visited;  // Cellules déjà visitées par la génération (même découpage que hWalls)
+    std::vector<int> stack;         // Pile explicite de la génération, conservée pour éviter les réallocations
+
+    static bool TestBit(const std::vector<uint64_t>& plane, size_t stride, int x, int y) {
+        return (plane[(size_t)y * stride + (x >> 6)] >> (x & 63)) & 1;
+    }
+    static void SetBit(std::vector<uint64_t>& plane, size_t stride, int x, int y) {
+        plane[(size_t)y * stride + (x >> 6)] |= (uint64_t)1 << (x & 63);
+    }
+    static void ClearBit(std::vector<uint64_t>& plane, size_t stride, int x, int y) {
+        plane[(size_t)y * stride + (x >> 6)] &= ~((uint64_t)1 << (x & 63));
+    }
+
+public:
+    // Directions utilisées pour désigner un mur d'une cellule
+    enum Direction { UP = 0, RIGHT = 1, DOWN = 2, LEFT = 3 };
+
+    // Constructeur qui alloue une grille de la taille demandée, tous murs présents
+    MazeGrid(int width = 0, int height = 0) : width(0), height(0), hStride(0), vStride(0) {
+        Resize(width, height);
+    }
+
+    // Change les dimensions de la grille et la réinitialise
+    void Resize(int newWidth, int newHeight) {
+        width = newWidth;
+        height = newHeight;
+        hStride = ((size_t)width + 63) / 64;
+        vStride = ((size_t)width + 1 + 63) / 64;
+        hWalls.resize(hStride * (height + 1));
+        vWalls.resize(vStride * height);
+        visited.resize(hStride * height);
+        Reset();
+    }
+
+    // Remet tous les murs et marque toutes les cellules comme non visitées (remplissage mot par mot)
+    void Reset() {
+        std::fill(hWalls.begin(), hWalls.end(), ~(uint64_t)0);
+        std::fill(vWalls.begin(), vWalls.end(), ~(uint64_t)0);
+        std::fill(visited.begin(), visited.end(), (uint64_t)0);
+    }
+
+    // Supprime le mur de la cellule (x, y) dans la direction donnée (et donc celui de sa voisine)
+    void RemoveWall(int x, int y, int direction) {
+        switch (direction) {
+            case UP: ClearBit(hWalls, hStride, x, y); break;
+            case RIGHT: ClearBit(vWalls, vStride, x + 1, y); break;
+            case DOWN: ClearBit(hWalls, hStride, x, y + 1); break;
+            case LEFT: ClearBit(vWalls, vStride, x, y); break;
+        }
+    }
+
+    // Remet le mur de la cellule (x, y) dans la direction donnée (et donc celui de sa voisine)
+    void AddWall(int x, int y, int direction) {
+        switch (direction) {
+            case UP: SetBit(hWalls, hStride, x, y); break;
+            case RIGHT: SetBit(vWalls, vStride, x + 1, y); break;
+            case DOWN: SetBit(hWalls, hStride, x, y + 1); break;
+            case LEFT: SetBit(vWalls, vStride, x, y); break;
+        }
+    }
+
+    // Indique si la cellule (x, y) a déjà été visitée par la génération
+    bool IsVisited(int x, int y) const { return TestBit(visited, hStride, x, y); }
+    void SetVisited(int x, int y) { SetBit(visited, hStride, x, y); }
+
+    // Génère un chemin par backtracking à partir de (startX, startY).
+    // La récursion est remplacée par une pile explicite : la profondeur n'est plus limitée par la pile d'appels.
+    void GeneratePath(int startX, int startY, Rng& random) {
+        stack.clear();
+        stack.push_back(startY * width + startX);
+        SetVisited(startX, startY);  // Marque la cellule de départ comme visitée
+
+        while (!stack.empty()) {
+            int current = stack.back();
+            int x = current % width;
+            int y = current / width;
+
+            // Tableau de directions possibles : 0 = haut, 1 = droite, 2 = bas, 3 = gauche
+            int directions[] = {UP, RIGHT, DOWN, LEFT};
+
+            // Mélange aléatoirement les directions pour diversifier le parcours
+            for (int i = 0; i < 4; i++) {
+                int j = random.Range(i, 3);
+                int temp = directions[i];
+                directions[i] = directions[j];
+                directions[j] = temp;
+            }
+
+            bool moved = false;  // Indicateur si un mouvement a été effectué
+            for (int i = 0; i < 4; i++) {
+                int nx = x, ny = y;
+                // Calcul de la nouvelle position en fonction de la direction
+                if (directions[i] == UP) ny -= 1;
+                else if (directions[i] == RIGHT) nx += 1;
+                else if (directions[i] == DOWN) ny += 1;
+                else if (directions[i] == LEFT) nx -= 1;
+
+                // Vérifie si la nouvelle position est valide et si la cellule n'est pas visitée
+                if (nx >= 0 && nx < width && ny >= 0 && ny < height && !IsVisited(nx, ny)) {
+                    RemoveWall(x, y, directions[i]);  // Un seul bit pour le mur partagé entre les deux cellules
+                    SetVisited(nx, ny);
+                    stack.push_back(ny * width + nx);  // Empile la voisine au lieu de faire un appel récursif
+                    moved = true;
+                    break;  // Sort de la boucle dès qu'un mouvement est effectué
+                }
+            }
+            if (!moved) stack.pop_back();  // Impasse : on revient à la cellule précédente
+        }
+    }
+
+    // Recopie les murs intérieurs d'une grille plus petite (tuile) à la position (x0, y0).
+    // x0 doit être un multiple de 64 : chaque ligne de la tuile tombe alors sur des mots entiers,
+    // et deux tuiles disjointes peuvent être recopiées en même temps depuis des threads différents.
+    // Les murs du bord de la tuile ne sont pas recopiés ; ils restent ceux de cette grille.
+    void CopyTile(const MazeGrid& tile, int x0, int y0) {
+        size_t word = (size_t)x0 >> 6;
+        for (int y = 1; y < tile.height; y++) {  // Murs horizontaux intérieurs à la tuile
+            const uint64_t* source = &tile.hWalls[(size_t)y * tile.hStride];
+            std::copy(source, source + tile.hStride, &hWalls[(size_t)(y0 + y) * hStride + word]);
+        }
+        for (int y = 0; y < tile.height; y++) {  // Murs verticaux, sans le bord droit (premier bit de la tuile voisine)
+            const uint64_t* source = &tile.vWalls[(size_t)y * tile.vStride];
+            std::copy(source, source + tile.hStride, &vWalls[(size_t)(y0 + y) * vStride + word]);
+        }
+    }
+
+    // Empreinte des murs (FNV-1a sur les plans de bits) : deux labyrinthes identiques ont la même empreinte
+    uint64_t Checksum() const {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        for (uint64_t word : hWalls) hash = (hash ^ word) * 0x100000001B3ULL;
+        for (uint64_t word : vWalls) hash = (hash ^ word) * 0x100000001B3ULL;
+        return hash;
+    }
+
+    // Vérifie s'il y a un mur dans la direction donnée par dx et dy depuis la cellule (x, y)
+    bool HasWall(int x, int y, int dx, int dy) const {
+        if (dx == -1) return TestBit(vWalls, vStride, x, y);      // Mur gauche
+        if (dx == 1) return TestBit(vWalls, vStride, x + 1, y);   // Mur droit
+        if (dy == -1) return TestBit(hWalls, hStride, x, y);      // Mur supérieur
+        if (dy == 1) return TestBit(hWalls, hStride, x, y + 1);   // Mur inférieur
+        return false;  // Si aucun mur, retourne false
+    }
+
+    // Mur horizontal d'indice (x, y), 0 <= y <= height : mur au-dessus de la cellule (x, y)
+    bool HasHorizontalWall(int x, int y) const { return TestBit(hWalls, hStride, x, y); }
+    // Mur vertical d'indice (x, y), 0 <= x <= width : mur à gauche de la cellule (x, y)
+    bool HasVerticalWall(int x, int y) const { return TestBit(vWalls, vStride, x, y); }
+
+    // Mémoire occupée par les plans de bits (en octets)
+    size_t MemoryBytes() const {
+        return (hWalls.size() + vWalls.size() + visited.size()) * sizeof(uint64_t);
+    }
+
+    // Mémoire réservée par la pile de GeneratePath (en octets)
+    size_t ScratchBytes() const { return stack.capacity() * sizeof(int); }
+
+    // Accesseurs pour obtenir la largeur et la hauteur de la grille
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+};
+
+#endif
@@ -0,0 +1,169 @@
+// Outil des paquets de niveaux (maze_file.h) : construit un paquet de labyrinthes générés et mis au point
+// pour un niveau, affiche son contenu et vérifie chaque labyrinthe.
+//
+//   ./maze_pack build <paquet.mzp> <nombre> [LARGEURxHAUTEUR] [niveau 0-2, -1 : aucun] [algorithme|all] [graine]
+//   ./maze_pack info <paquet.mzp> [index]    (avec un index : métadonnées et dessin du labyrinthe)
+//   ./maze_pack verify <paquet.mzp>          (empreintes, labyrinthes parfaits, temps d'accès)
+//
+// Le labyrinthe n du paquet a la graine graine + n ; avec "all", les algorithmes se succèdent.
+// Les labyrinthes sont générés en parallèle sur le pool partagé (job_system.h), puis ajoutés dans l'ordre :
+// le paquet ne dépend pas du nombre de threads.
+// Compilé sans raylib : make pack
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "job_system.h"
+#include "maze_file.h"
+#include "maze_stats.h"
+#include "simulation.h"
+
+using namespace std;
+
+static int Usage(const char* program) {
+    fprintf(stderr, "usage: %s build <paquet.mzp> <nombre> [LARGEURxHAUTEUR] [niveau] [algorithme|all] [graine]\n"
+                    "       %s info <paquet.mzp> [index]\n"
+                    "       %s verify <paquet.mzp>\n", program, program, program);
+    return 1;
+}
+
+static int Build(int argc, char* argv[]) {
+    const char* path = argv[2];
+    int count = atoi(argv[3]);
+    int width = 20, height = 15;
+    int level = Niveau::FACILE;
+    int algorithm = -1;  // -1 : tous les algorithmes à tour de rôle
+    unsigned long long seed = 1234;
+    if (argc > 4) sscanf(argv[4], "%dx%d", &width, &height);
+    if (argc > 5) level = atoi(argv[5]);
+    if (argc > 6 && strcmp(argv[6], "all") != 0) {
+        for (int a = 0; a < ALGORITHM_COUNT; a++) {
+            if (strcmp(argv[6], MazeAlgorithmName((MazeAlgorithm)a)) == 0) algorithm = a;
+        }
+        if (algorithm < 0) {
+            fprintf(stderr, "algorithme inconnu : %s\n", argv[6]);
+            return 1;
+        }
+    }
+    if (argc > 7) seed = strtoull(argv[7], NULL, 0);
+    if (count < 1 || width < 2 || height < 2 || level < -1 || level > Niveau::DIFFICILE) return Usage(argv[0]);
+
+    DifficultyTarget target = level >= 0 ? Niveau((Niveau::Level)level).getDifficultyTarget() : DifficultyTarget::Any();
+    vector<MazeGrid> grids(count);
+    vector<MazeInfo> infos(count);
+    auto start = chrono::steady_clock::now();
+    Jobs().ParallelFor(count, [&](int n) {
+        MazeAlgorithm mazeAlgorithm = (MazeAlgorithm)(algorithm >= 0 ? algorithm : n % ALGORITHM_COUNT);
+        Maze maze(width, height, seed + n, mazeAlgorithm, target);
+        MazeStats stats = ComputeMazeStats(maze.GetGrid());
+        grids[n] = maze.GetGrid();
+        infos[n] = MazeInfo{maze.GetId(), level, stats.solutionLength, stats.deadEnds, ""};
+    });
+
+    MazePackWriter writer;
+    for (int n = 0; n < count; n++) {
+        if (!writer.Add(grids[n], infos[n])) {
+            fprintf(stderr, "labyrinthe %d non représentable (bord ouvert)\n", n);
+            return 1;
+        }
+    }
+    if (!writer.Write(path)) {
+        fprintf(stderr, "impossible d'écrire %s\n", path);
+        return 1;
+    }
+    double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    MazePack pack;
+    pack.Open(path);
+    printf("%d labyrinthes %dx%d écrits dans %s en %.1f ms (%zu octets, %.1f octets par labyrinthe)\n",
+           count, width, height, path, ms, pack.GetFileSize(), (double)pack.GetFileSize() / count);
+    return 0;
+}
+
+static void PrintRecord(int index, const MazeRecord& record) {
+    MazeInfo info = record.GetInfo();
+    char id[96];
+    info.id.Format(id, sizeof(id));
+    printf("%6d  %s  niveau %2d  solution %5d  impasses %5d  empreinte %016llx%s%s\n", index, id, info.level,
+           info.solutionLength, info.deadEnds, (unsigned long long)record.GetChecksum(),
+           info.name.empty() ? "" : "  ", info.name.c_str());
+}
+
+static int Info(int argc, char* argv[]) {
+    MazePack pack;
+    if (!pack.Open(argv[2])) {
+        fprintf(stderr, "%s : paquet illisible (absent, tronqué ou d'une autre version)\n", argv[2]);
+        return 1;
+    }
+    printf("%s : %d labyrinthes, %zu octets, version %d\n", argv[2], pack.GetCount(), pack.GetFileSize(), MAZE_PACK_VERSION);
+    if (argc <= 3) {
+        for (int i = 0; i < pack.GetCount(); i++) {
+            MazeRecord record = pack.Get(i);
+            if (record.IsValid()) PrintRecord(i, record);
+            else printf("%6d  entrée abîmée\n", i);
+        }
+        return 0;
+    }
+
+    int index = atoi(argv[3]);
+    MazeRecord record = pack.Get(index);
+    if (!record.IsValid()) {
+        fprintf(stderr, "labyrinthe %d absent ou abîmé\n", index);
+        return 1;
+    }
+    PrintRecord(index, record);
+
+    // Dessin en texte, lu directement dans le fichier projeté
+    MazeId id = record.GetId();
+    if (id.width > 100) return 0;
+    for (int y = 0; y < id.height; y++) {
+        for (int x = 0; x < id.width; x++) printf(record.HasWall(x, y, 0, -1) ? "+--" : "+  ");
+        printf("+\n");
+        for (int x = 0; x < id.width; x++) printf(record.HasWall(x, y, -1, 0) ? "|  " : "   ");
+        printf(record.HasWall(id.width - 1, y, 1, 0) ? "|\n" : "\n");
+    }
+    for (int x = 0; x < id.width; x++) printf("+--");
+    printf("+\n");
+    return 0;
+}
+
+static int Verify(char* argv[]) {
+    auto start = chrono::steady_clock::now();
+    MazePack pack;
+    if (!pack.Open(argv[2])) {
+        fprintf(stderr, "%s : paquet illisible (absent, tronqué ou d'une autre version)\n", argv[2]);
+        return 1;
+    }
+    double openUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+
+    MazeGrid grid;
+    int failures = 0;
+    double decodeUs = 0;
+    for (int i = 0; i < pack.GetCount(); i++) {
+        auto decodeStart = chrono::steady_clock::now();
+        MazeRecord record = pack.Get(i);
+        bool decoded = record.IsValid() && record.Decode(grid);
+        decodeUs += chrono::duration<double, micro>(chrono::steady_clock::now() - decodeStart).count();
+        if (!decoded) {
+            printf("%6d  entrée abîmée ou empreinte fausse\n", i);
+            failures++;
+            continue;
+        }
+        MazeStats stats = ComputeMazeStats(grid);
+        MazeInfo info = record.GetInfo();
+        if (!stats.perfect || stats.solutionLength != info.solutionLength || stats.deadEnds != info.deadEnds) {
+            printf("%6d  mesures différentes de celles enregistrées\n", i);
+            failures++;
+        }
+    }
+    printf("%d labyrinthes, %d erreurs ; ouverture %.1f us, accès et décodage %.2f us par labyrinthe\n",
+           pack.GetCount(), failures, openUs, pack.GetCount() ? decodeUs / pack.GetCount() : 0.0);
+    return failures ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 4 && strcmp(argv[1], "build") == 0) return Build(argc, argv);
+    if (argc >= 3 && strcmp(argv[1], "info") == 0) return Info(argc, argv);
+    if (argc >= 3 && strcmp(argv[1], "verify") == 0) return Verify(argv);
+    return Usage(argv[0]);
+}
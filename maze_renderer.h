@@ -0,0 +1,272 @@
+#ifndef MAZE_RENDERER_H
+#define MAZE_RENDERER_H
+
+// Disposition et dessin du labyrinthe de la simulation et du labyrinthe sans fin.
+// Seule partie du dessin dont le coût dépend de la taille du labyrinthe : séparée de main.cpp pour être
+// mesurée par microbench.cpp avec un raylib factice (null_raylib/raylib.h) qui compte les appels de dessin.
+
+#include <raylib.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "simulation.h"
+#include "chunked_maze.h"
+#include "wall_mesh.h"
+#include "asset_cache.h"
+
+// Constants
+#define SCREEN_WIDTH 800    // Définition de la largeur de la fenêtre d'affichage (en pixels)
+#define SCREEN_HEIGHT 600   // Définition de la hauteur de la fenêtre d'affichage (en pixels)
+#define CELL_SIZE 40        // Définition de la taille d'une cellule du labyrinthe (en pixels)
+#define GRID_WIDTH (SCREEN_WIDTH / CELL_SIZE)  // Calcul du nombre de cellules en largeur en fonction de la taille de la fenêtre et de la taille de la cellule
+#define GRID_HEIGHT (SCREEN_HEIGHT / CELL_SIZE) // Calcul du nombre de cellules en hauteur en fonction de la taille de la fenêtre et de la taille de la cellule
+
+// Disposition du labyrinthe à l'écran, partagée par le dessin du labyrinthe, du joueur, des obstacles et de l'objectif.
+// Si les cellules deviennent trop petites pour tenir dans 75% de la fenêtre, la vue passe en mode caméra :
+// le labyrinthe garde sa taille de cellule et une Camera2D suit le joueur.
+class MazeView {
+public:
+    float scaleFactor;          // Facteur d'échelle de la zone du labyrinthe
+    int offsetX, offsetY;       // Origine du labyrinthe (à l'écran en mode fixe, dans le monde en mode caméra)
+    int cellSize;               // Taille d'une cellule mise à l'échelle (en pixels)
+    int gridWidth, gridHeight;  // Dimensions du labyrinthe (en cellules)
+    bool scrolling;             // Vrai si la caméra suit le joueur
+    bool bounded;               // Faux pour le labyrinthe sans fin : la caméra n'est pas limitée aux bords
+    Camera2D camera;            // Caméra utilisée en mode défilement
+
+    // Taille minimale d'une cellule en mode fixe ; en dessous, on passe en mode caméra
+    static const int MIN_CELL_SIZE = 16;
+
+    MazeView(int width = GRID_WIDTH, int height = GRID_HEIGHT) : scaleFactor(0.75f), gridWidth(width), gridHeight(height), bounded(true) {
+        int reducedWidth = scaleFactor * SCREEN_WIDTH;  // Largeur réduite en fonction du facteur d'échelle
+        int reducedHeight = scaleFactor * SCREEN_HEIGHT; // Hauteur réduite en fonction du facteur d'échelle
+
+        cellSize = std::min(reducedWidth / gridWidth, reducedHeight / gridHeight);
+        scrolling = cellSize < MIN_CELL_SIZE;
+        camera = {};
+        camera.zoom = 1.0f;
+
+        if (scrolling) {
+            // Le labyrinthe est dessiné dans le monde à partir de (0, 0), la caméra centre le joueur à l'écran
+            cellSize = scaleFactor * CELL_SIZE;
+            offsetX = 0;
+            offsetY = 0;
+            camera.offset = {SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f};
+        } else {
+            // Décalages pour centrer le labyrinthe dans la fenêtre
+            offsetX = (SCREEN_WIDTH - gridWidth * cellSize) / 2;
+            offsetY = (SCREEN_HEIGHT - gridHeight * cellSize) / 2;
+        }
+    }
+
+    // Vue du labyrinthe sans fin : mode caméra, sans bords
+    static MazeView Endless() {
+        MazeView view(1, 1);
+        view.scrolling = true;
+        view.bounded = false;
+        view.cellSize = view.scaleFactor * CELL_SIZE;
+        view.offsetX = 0;
+        view.offsetY = 0;
+        view.camera.offset = {SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f};
+        return view;
+    }
+
+    // Centre la caméra sur le joueur (position en cellules, éventuellement interpolée),
+    // sans montrer l'extérieur du labyrinthe quand c'est possible
+    void Follow(float playerX, float playerY) {
+        if (!scrolling) return;
+        float worldWidth = (float)gridWidth * cellSize;
+        float worldHeight = (float)gridHeight * cellSize;
+        float targetX = (playerX + 0.5f) * cellSize;
+        float targetY = (playerY + 0.5f) * cellSize;
+        if (!bounded) {
+            camera.target = {targetX, targetY};
+            return;
+        }
+        if (worldWidth > SCREEN_WIDTH) targetX = Clamp(targetX, camera.offset.x, worldWidth - camera.offset.x);
+        if (worldHeight > SCREEN_HEIGHT) targetY = Clamp(targetY, camera.offset.y, worldHeight - camera.offset.y);
+        camera.target = {targetX, targetY};
+    }
+
+    // Encadre le dessin des éléments placés dans le labyrinthe (murs, joueur, obstacles, objectif)
+    void BeginWorld() const { if (scrolling) BeginMode2D(camera); }
+    void EndWorld() const { if (scrolling) EndMode2D(); }
+
+    // Rectangle de cellules [x0, x1) x [y0, y1) visible à l'écran
+    void GetVisibleCells(int& x0, int& y0, int& x1, int& y1) const {
+        if (!scrolling) {
+            x0 = 0; y0 = 0; x1 = gridWidth; y1 = gridHeight;
+            return;
+        }
+        float left = camera.target.x - camera.offset.x;
+        float top = camera.target.y - camera.offset.y;
+        x0 = (int)std::floor(left / cellSize);
+        y0 = (int)std::floor(top / cellSize);
+        x1 = (int)std::ceil((left + SCREEN_WIDTH) / cellSize);
+        y1 = (int)std::ceil((top + SCREEN_HEIGHT) / cellSize);
+        if (bounded) {
+            x0 = std::max(0, x0);
+            y0 = std::max(0, y0);
+            x1 = std::min(gridWidth, x1);
+            y1 = std::min(gridHeight, y1);
+        }
+    }
+
+private:
+    static float Clamp(float value, float low, float high) {
+        return value < low ? low : (value > high ? high : value);
+    }
+};
+
+// Dessin du labyrinthe de la simulation : couche des murs mise en cache en mode fixe,
+// segments des seules cellules visibles en mode caméra
+class MazeRenderer {
+private:
+    Texture2D wallTexture;                 // Texture des murs du labyrinthe
+    WallMesh visibleMesh;                  // Segments des seules cellules visibles (mode caméra), reconstruits à chaque image
+    RenderTexture2D wallLayer;             // Couche hors écran contenant les murs déjà dessinés
+    unsigned bakedGeneration;              // Génération du labyrinthe contenue dans la couche des murs
+    bool wallsDirty;                       // Indique que la couche des murs doit être redessinée
+
+    // Dessine les segments de murs fusionnés à partir de l'origine (originX, originY).
+    // Avec clampInside, les murs de bordure sont ramenés à l'intérieur de la grille ; les blocs du mode
+    // sans fin sont accolés et dessinent leurs murs centrés sur les arêtes, y compris en bordure.
+    void DrawWalls(const MazeGrid& grid, const WallMesh& mesh, int originX, int originY, int scaledCellSize,
+                   bool clampInside = true) {
+        int lineThickness = 4;  // Épaisseur des murs du labyrinthe
+        int half = lineThickness / 2;
+        int mazeWidth = grid.GetWidth() * scaledCellSize;
+        int mazeHeight = grid.GetHeight() * scaledCellSize;
+
+        const std::vector<WallRun>& runs = mesh.GetRuns();
+        for (size_t i = 0; i < runs.size(); i++) {
+            const WallRun& run = runs[i];
+            int left, top, right, bottom;
+            Rectangle source;
+            if (run.horizontal) {
+                // Segment centré sur la ligne d'arête, prolongé d'une demi-épaisseur pour fermer les coins,
+                // et ramené à l'intérieur de la zone du labyrinthe pour les murs de bordure
+                left = run.x * scaledCellSize - half;
+                right = (run.x + run.length) * scaledCellSize + half;
+                top = run.y * scaledCellSize - half;
+                if (clampInside) {
+                    left = std::max(left, 0);
+                    right = std::min(right, mazeWidth);
+                    top = std::min(std::max(top, 0), mazeHeight - lineThickness);
+                }
+                bottom = top + lineThickness;
+                // La texture est répétée une fois par cellule, comme avec le dessin cellule par cellule
+                source = {0, 0, (float)wallTexture.width * run.length, (float)wallTexture.height};
+            } else {
+                left = run.x * scaledCellSize - half;
+                top = run.y * scaledCellSize - half;
+                bottom = (run.y + run.length) * scaledCellSize + half;
+                if (clampInside) {
+                    left = std::min(std::max(left, 0), mazeWidth - lineThickness);
+                    top = std::max(top, 0);
+                    bottom = std::min(bottom, mazeHeight);
+                }
+                right = left + lineThickness;
+                source = {0, 0, (float)wallTexture.width, (float)wallTexture.height * run.length};
+            }
+
+            DrawTexturePro(
+                wallTexture,
+                source,
+                {(float)(originX + left), (float)(originY + top), (float)(right - left), (float)(bottom - top)},
+                {0, 0},
+                0.0f,
+                WHITE
+            );
+        }
+    }
+
+    // Redessine les murs dans la couche hors écran, recréée si la taille des cellules a changé
+    void BakeWallLayer(const Maze& maze, int scaledCellSize) {
+        int layerWidth = maze.GetGridWidth() * scaledCellSize;
+        int layerHeight = maze.GetGridHeight() * scaledCellSize;
+        if (wallLayer.id == 0 || wallLayer.texture.width != layerWidth || wallLayer.texture.height != layerHeight) {
+            if (wallLayer.id != 0) UnloadRenderTexture(wallLayer);
+            wallLayer = LoadRenderTexture(layerWidth, layerHeight);
+        }
+
+        BeginTextureMode(wallLayer);
+        ClearBackground(BLANK);  // Fond transparent : seul le sol de l'écran reste visible entre les murs
+        DrawWalls(maze.GetGrid(), maze.GetWallMesh(), 0, 0, scaledCellSize);
+        EndTextureMode();
+        wallsDirty = false;
+    }
+
+public:
+    MazeRenderer() : wallLayer{}, bakedGeneration(0), wallsDirty(true) {
+        wallTexture = Assets().AcquireTexture("brick.png");  // Texture des murs, partagée par le cache
+    }
+
+    // Destructeur qui rend la texture des murs et libère la couche hors écran
+    ~MazeRenderer() {
+        Assets().Release("brick.png");  // Rend la texture utilisée pour les murs au cache
+        if (wallLayer.id != 0) UnloadRenderTexture(wallLayer);  // Libère la couche des murs
+    }
+
+    // Dessine le labyrinthe à l'écran selon la disposition donnée.
+    // En mode caméra, doit être appelé entre view.BeginWorld() et view.EndWorld().
+    void DrawMaze(const Maze& maze, const MazeView& view) {
+        // Le labyrinthe a changé depuis la dernière image (génération, réinitialisation ou échange de tampons)
+        if (maze.GetGeneration() != bakedGeneration) {
+            bakedGeneration = maze.GetGeneration();
+            wallsDirty = true;
+            char id[96];
+            maze.GetId().Format(id, sizeof(id));  // Identifiant à partager pour rejouer ce labyrinthe
+            Position start = maze.GetStart();  // Cellule de départ d'une régénération (sinon tirée de la graine)
+            if (start.x >= 0) {
+                size_t length = strlen(id);
+                snprintf(id + length, sizeof(id) - length, " depuis (%d, %d)", start.x, start.y);
+            }
+            if (view.scrolling) {
+                // Les segments complets ne servent pas en mode caméra : inutile de les faire reconstruire
+                TraceLog(LOG_INFO, "MAZE: %s", id);
+            } else {
+                const WallMesh& mesh = maze.GetWallMesh();
+                TraceLog(LOG_INFO, "MAZE: %s, %d segments de murs au lieu de %d (%d appels de dessin économisés)",
+                         id, mesh.GetRunCount(), mesh.GetCellSegments(), mesh.GetDrawCallsSaved());
+            }
+        }
+
+        if (view.scrolling) {
+            // Seules les cellules visibles sont parcourues : le coût dépend de la taille de l'écran, pas du labyrinthe
+            int x0, y0, x1, y1;
+            view.GetVisibleCells(x0, y0, x1, y1);
+            visibleMesh.Build(maze.GetGrid(), x0, y0, x1, y1);
+            DrawWalls(maze.GetGrid(), visibleMesh, view.offsetX, view.offsetY, view.cellSize);
+        } else {
+            // Redessine la couche des murs uniquement si le labyrinthe a changé depuis la dernière image
+            if (wallsDirty) {
+                BakeWallLayer(maze, view.cellSize);
+            }
+
+            // Une seule copie de la couche des murs (hauteur négative : les textures de rendu sont inversées verticalement)
+            DrawTextureRec(wallLayer.texture,
+                {0, 0, (float)wallLayer.texture.width, -(float)wallLayer.texture.height},
+                {(float)view.offsetX, (float)view.offsetY}, WHITE);
+        }
+    }
+
+    // Dessine les blocs visibles du labyrinthe sans fin (entre view.BeginWorld() et view.EndWorld()).
+    // Chaque bloc ne dessine que ses murs du haut et de gauche : les autres appartiennent à ses voisins.
+    void DrawEndless(ChunkedMaze& maze, const MazeView& view) {
+        int x0, y0, x1, y1;
+        view.GetVisibleCells(x0, y0, x1, y1);
+        const int size = ChunkedMaze::CHUNK_SIZE;
+        for (int cy = ChunkedMaze::ChunkCoord(y0); cy <= ChunkedMaze::ChunkCoord(y1); cy++) {
+            for (int cx = ChunkedMaze::ChunkCoord(x0); cx <= ChunkedMaze::ChunkCoord(x1); cx++) {
+                const MazeGrid& grid = maze.GetChunk(cx, cy);
+                visibleMesh.Build(grid, 0, 0, size, size, false);
+                DrawWalls(grid, visibleMesh, cx * size * view.cellSize, cy * size * view.cellSize, view.cellSize, false);
+            }
+        }
+    }
+};
+
+#endif
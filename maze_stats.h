@@ -0,0 +1,84 @@
+#ifndef MAZE_STATS_H
+#define MAZE_STATS_H
+
+#include <stdint.h>
+#include <vector>
+#include "maze_grid.h"
+
+// Mesures de la forme d'un labyrinthe, pour comparer les algorithmes de génération
+struct MazeStats {
+    int deadEnds;          // Cellules avec une seule ouverture
+    double deadEndRatio;   // Proportion d'impasses parmi les cellules
+    int solutionLength;    // Nombre de déplacements du départ (0, 0) à l'arrivée (width - 1, height - 1), -1 si inaccessible
+    int junctions;         // Cellules avec au moins trois ouvertures (carrefours)
+    double branchingFactor; // Nombre moyen de choix offerts à chaque pas de la solution (sans compter le demi-tour)
+    bool perfect;          // Vrai si toutes les cellules sont accessibles et qu'il n'y a aucune boucle
+};
+
+// Calcule les mesures par un parcours en largeur depuis la cellule de départ (0, 0)
+inline MazeStats ComputeMazeStats(const MazeGrid& grid) {
+    int width = grid.GetWidth();
+    int height = grid.GetHeight();
+    size_t count = (size_t)width * height;
+    const int dx[4] = {0, 1, 0, -1};
+    const int dy[4] = {-1, 0, 1, 0};
+
+    MazeStats stats = {0, 0.0, -1, 0, 0.0, false};
+    std::vector<int> distance(count, -1);
+    std::vector<int> queue;
+    std::vector<uint8_t> exitCount(count, 0);  // Nombre d'ouvertures de chaque cellule atteinte
+    queue.reserve(count);
+
+    long long openings = 0;  // Chaque passage est compté depuis ses deux cellules
+    distance[0] = 0;
+    queue.push_back(0);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int cell = queue[head];
+        int x = cell % width, y = cell / width;
+        int exits = 0;
+        for (int d = 0; d < 4; d++) {
+            int nx = x + dx[d], ny = y + dy[d];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height || grid.HasWall(x, y, dx[d], dy[d])) continue;
+            exits++;
+            int next = ny * width + nx;
+            if (distance[next] < 0) {
+                distance[next] = distance[cell] + 1;
+                queue.push_back(next);
+            }
+        }
+        openings += exits;
+        exitCount[cell] = (uint8_t)exits;
+        if (exits == 1) stats.deadEnds++;
+        if (exits >= 3) stats.junctions++;
+    }
+
+    stats.deadEndRatio = count ? (double)stats.deadEnds / count : 0.0;
+    stats.solutionLength = distance[count - 1];
+
+    // Remonte la solution depuis l'arrivée : à chaque cellule du chemin, les choix sont ses ouvertures
+    // moins celle par laquelle on est arrivé (aucune au départ)
+    if (stats.solutionLength > 0) {
+        long long choices = 0;
+        int cell = (int)count - 1;
+        while (cell != 0) {
+            int x = cell % width, y = cell / width;
+            int previous = cell;
+            for (int d = 0; d < 4; d++) {
+                int nx = x + dx[d], ny = y + dy[d];
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height || grid.HasWall(x, y, dx[d], dy[d])) continue;
+                if (distance[ny * width + nx] == distance[cell] - 1) {
+                    previous = ny * width + nx;
+                    break;
+                }
+            }
+            choices += exitCount[previous] - (previous != 0 ? 1 : 0);
+            cell = previous;
+        }
+        stats.branchingFactor = (double)choices / stats.solutionLength;
+    }
+    // Un arbre couvrant : toutes les cellules atteintes et exactement count - 1 passages
+    stats.perfect = queue.size() == count && openings / 2 == (long long)count - 1;
+    return stats;
+}
+
+#endif
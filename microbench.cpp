@@ -0,0 +1,199 @@
+// Microbenchmarks des chemins critiques du jeu : Maze::InitializeMaze, MazeGrid::GeneratePath, Maze::Regenerate,
+// Maze::HasWall, Player::Move, le pas des obstacles, la lecture d'un paquet de niveaux et MazeRenderer::DrawMaze, ce dernier avec un raylib factice
+// (null_raylib/raylib.h) qui compte les appels de dessin au lieu de dessiner.
+//
+// Graines et tailles de grille fixes ; la sortie est un CSV sur la sortie standard, une ligne par mesure :
+//   benchmark,grid,ops,ns_per_op,ns_per_op_min,check
+// ns_per_op est la médiane des lots, ns_per_op_min le meilleur lot ; check est calculé à partir du résultat
+// du premier lot (empreinte des murs, positions, appels de dessin) : deux exécutions qui font le même travail
+// ont le même check, ce qui permet de comparer deux commits avec un simple diff des colonnes.
+// Compilé sans raylib : make microbench && ./microbench [secondes par mesure] [filtre]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "maze_file.h"
+#include "simulation.h"
+#include "maze_renderer.h"
+
+using namespace std;
+
+static double minSeconds = 0.2;      // Durée minimale de mesure par benchmark
+static const int MIN_BATCHES = 5;    // Nombre minimal de lots (la médiane a besoin de plusieurs valeurs)
+static const char* filter = nullptr; // Seuls les benchmarks dont le nom contient ce texte sont exécutés
+
+// Tailles de grille testées : la grille du jeu (vue fixe), puis deux grandes grilles (vue caméra)
+static const int SIZES[][2] = {{GRID_WIDTH, GRID_HEIGHT}, {256, 256}, {1024, 1024}};
+
+// Exécute body (qui fait ops opérations et renvoie une valeur de contrôle) par lots jusqu'à minSeconds,
+// puis écrit la ligne CSV de la mesure
+template <typename Body>
+static void Measure(const char* name, int width, int height, long ops, Body body) {
+    if (filter && !strstr(name, filter)) return;
+    vector<double> batches;
+    uint64_t check = 0;
+    double elapsed = 0;
+    while (elapsed < minSeconds || (int)batches.size() < MIN_BATCHES) {
+        auto start = chrono::steady_clock::now();
+        uint64_t result = body();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (batches.empty()) check = result;
+        batches.push_back(seconds * 1e9 / ops);
+        elapsed += seconds;
+    }
+    sort(batches.begin(), batches.end());
+    printf("%s,%dx%d,%ld,%.2f,%.2f,%llu\n", name, width, height, ops * (long)batches.size(),
+           batches[batches.size() / 2], batches[0], (unsigned long long)check);
+    fflush(stdout);
+}
+
+// Déplacements tirés d'avance (une direction par pas), pour ne mesurer que le code testé
+static vector<Position> RandomSteps(size_t count, uint64_t seed) {
+    const int dx[4] = {1, 0, -1, 0};
+    const int dy[4] = {0, 1, 0, -1};
+    Rng random(seed);
+    vector<Position> steps(count);
+    for (size_t i = 0; i < count; i++) {
+        int d = random.Range(0, 3);
+        steps[i] = Position(dx[d], dy[d]);
+    }
+    return steps;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) minSeconds = atof(argv[1]);
+    if (argc > 2) filter = argv[2];
+    const uint64_t seed = 1234;  // Graine fixe pour que deux exécutions soient comparables
+
+    printf("benchmark,grid,ops,ns_per_op,ns_per_op_min,check\n");
+    for (const auto& size : SIZES) {
+        int width = size[0], height = size[1];
+
+        // Remise à zéro des murs (un remplissage mot par mot)
+        {
+            Maze maze(width, height, seed);
+            Measure("initialize_maze", width, height, 1000, [&]() {
+                for (int i = 0; i < 1000; i++) maze.InitializeMaze();
+                return maze.GetGrid().Checksum();
+            });
+        }
+
+        // Génération par backtracking seule, remise à zéro comprise (une opération par labyrinthe)
+        {
+            MazeGrid grid(width, height);
+            Rng random(seed);
+            Measure("generate_path", width, height, 1, [&]() {
+                grid.Reset();
+                grid.GeneratePath(0, 0, random);
+                return grid.Checksum();
+            });
+        }
+
+        // Régénération complète : génération, segments de murs et champ de distances
+        {
+            Maze maze(width, height, seed);
+            Measure("regenerate", width, height, 1, [&]() {
+                maze.Regenerate();
+                return maze.GetGrid().Checksum();
+            });
+        }
+
+        // Lecture des murs dans les quatre directions de cellules tirées au hasard
+        {
+            Maze maze(width, height, seed);
+            const int count = 1 << 16;
+            vector<Position> cellsToTest(count);
+            Rng random(seed);
+            for (Position& cell : cellsToTest) cell = Position(random.Range(0, width - 1), random.Range(0, height - 1));
+            Measure("has_wall", width, height, count * 4L, [&]() {
+                uint64_t walls = 0;
+                for (const Position& cell : cellsToTest) {
+                    walls += maze.HasWall(cell, 1, 0) + maze.HasWall(cell, -1, 0) + maze.HasWall(cell, 0, 1) + maze.HasWall(cell, 0, -1);
+                }
+                return walls;
+            });
+        }
+
+        // Marche aléatoire du joueur (bornes, murs et détection de la sortie)
+        {
+            Maze maze(width, height, seed);
+            Player player(0, 0, width, height);
+            vector<Position> steps = RandomSteps(1 << 16, seed);
+            Measure("player_move", width, height, (long)steps.size(), [&]() {
+                bool gameWon = false;
+                for (const Position& step : steps) player.Move(step.x, step.y, maze, gameWon);
+                return (uint64_t)player.position.y * width + player.position.x;
+            });
+        }
+
+        // Pas des obstacles avec la densité et les comportements de chaque niveau, le joueur se déplaçant
+        const char* swarmNames[] = {"obstacle_step_facile", "obstacle_step_moyen", "obstacle_step_difficile"};
+        for (int level = Niveau::FACILE; level <= Niveau::DIFFICILE; level++) {
+            Niveau niveau((Niveau::Level)level);
+            Maze maze(width, height, seed);
+            Player player(0, 0, width, height);
+            vector<Position> steps = RandomSteps(4096, seed);
+            ObstacleSwarm swarm(0.25f, seed + 1);
+            swarm.Spawn(max(1, niveau.getObstacleCount(width, height)), width, height, niveau.getObstacleBehaviors());
+            size_t next = 0;
+            Measure(swarmNames[level], width, height, 100, [&]() {
+                bool gameWon = false;
+                uint64_t hits = 0;
+                for (int i = 0; i < 100; i++) {
+                    const Position& step = steps[next++ % steps.size()];
+                    player.Move(step.x, step.y, maze, gameWon);
+                    swarm.BeginStep();
+                    swarm.Move(0.25f, maze.GetGrid(), player.position.x, player.position.y);  // Un déplacement par pas
+                    hits += swarm.IsOccupied(player.position.x, player.position.y);
+                }
+                return hits * 1000003 + (uint64_t)swarm.GetX(0) * height + swarm.GetY(0);
+            });
+        }
+
+        // Lecture d'un labyrinthe dans un paquet projeté en mémoire (accès par l'index, puis décodage des 2 bits par cellule)
+        {
+            const char* packPath = "microbench.mzp";
+            Maze maze(width, height, seed);
+            MazePackWriter writer;
+            writer.Add(maze.GetGrid(), MazeInfo{maze.GetId(), -1, 0, 0, ""});
+            MazePack pack;
+            if (writer.Write(packPath) && pack.Open(packPath)) {
+                MazeGrid grid(width, height);
+                Measure("pack_load", width, height, 1, [&]() {
+                    pack.Get(0).Decode(grid);
+                    return grid.Checksum();
+                });
+            }
+            pack.Close();
+            remove(packPath);
+        }
+
+        // Dessin d'une image du labyrinthe : copie de la couche des murs en vue fixe,
+        // segments des cellules visibles en vue caméra (la caméra suit un joueur qui se déplace)
+        {
+            Maze maze(width, height, seed);
+            MazeView view(width, height);
+            MazeRenderer renderer;
+            Player player(0, 0, width, height);
+            vector<Position> steps = RandomSteps(4096, seed);
+            size_t next = 0;
+            NullDraw().drawCalls = 0;
+            Measure(view.scrolling ? "draw_maze_camera" : "draw_maze_fixed", width, height, 100, [&]() {
+                bool gameWon = false;
+                long before = NullDraw().drawCalls;
+                for (int i = 0; i < 100; i++) {
+                    const Position& step = steps[next++ % steps.size()];
+                    player.Move(step.x, step.y, maze, gameWon);
+                    view.Follow((float)player.position.x, (float)player.position.y);
+                    view.BeginWorld();
+                    renderer.DrawMaze(maze, view);
+                    view.EndWorld();
+                }
+                return (uint64_t)(NullDraw().drawCalls - before);
+            });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#ifndef NULL_RAYLIB_H
+#define NULL_RAYLIB_H
+
+// Raylib factice pour les outils sans fenêtre (microbench.cpp) : les types et les fonctions utilisés par
+// maze_renderer.h et asset_cache.h, sans carte graphique ni fichiers. Les fonctions de dessin ne dessinent rien
+// et se contentent de compter les appels et la surface couverte, pour mesurer le coût du code de dessin lui-même.
+// Utilisé à la place du vrai raylib en plaçant ce répertoire en tête des chemins d'inclusion (-Inull_raylib).
+
+#include <string.h>
+
+typedef struct Vector2 { float x, y; } Vector2;
+typedef struct Rectangle { float x, y, width, height; } Rectangle;
+typedef struct Color { unsigned char r, g, b, a; } Color;
+typedef struct Image { void* data; int width, height, mipmaps, format; } Image;
+typedef struct Texture { unsigned int id; int width, height, mipmaps, format; } Texture;
+typedef Texture Texture2D;
+typedef struct RenderTexture { unsigned int id; Texture texture; Texture depth; } RenderTexture;
+typedef RenderTexture RenderTexture2D;
+typedef struct Camera2D { Vector2 offset; Vector2 target; float rotation; float zoom; } Camera2D;
+typedef struct AudioStream { void* buffer; void* processor; unsigned int sampleRate, sampleSize, channels; } AudioStream;
+typedef struct Music { AudioStream stream; unsigned int frameCount; bool looping; int ctxType; void* ctxData; } Music;
+
+#define CLITERAL(type) type
+#define WHITE CLITERAL(Color){255, 255, 255, 255}
+#define BLANK CLITERAL(Color){0, 0, 0, 0}
+
+enum { LOG_ALL, LOG_TRACE, LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_FATAL, LOG_NONE };
+
+// Compteurs du dessin factice, remis à zéro par l'appelant entre deux mesures
+struct NullDrawStats {
+    long drawCalls;        // Nombre de quads envoyés (DrawTexturePro, DrawTextureRec)
+    double pixels;         // Surface totale des quads (en pixels)
+    long layerPasses;      // Nombre de passes de rendu hors écran (BeginTextureMode)
+    unsigned int nextId;   // Prochain identifiant de texture
+};
+
+inline NullDrawStats& NullDraw() {
+    static NullDrawStats stats = {0, 0, 0, 1};
+    return stats;
+}
+
+// Images et textures : dimensions fixes, aucune donnée
+inline Image LoadImage(const char*) { return Image{nullptr, 32, 32, 1, 7}; }
+inline void UnloadImage(Image) {}
+inline Image GenImageColor(int width, int height, Color) { return Image{nullptr, width, height, 1, 7}; }
+inline void ImageDraw(Image*, Image, Rectangle, Rectangle, Color) {}
+inline Texture2D LoadTextureFromImage(Image image) {
+    return Texture2D{NullDraw().nextId++, image.width, image.height, 1, image.format};
+}
+inline void UnloadTexture(Texture2D) {}
+inline RenderTexture2D LoadRenderTexture(int width, int height) {
+    unsigned int id = NullDraw().nextId++;
+    return RenderTexture2D{id, Texture2D{id, width, height, 1, 7}, Texture2D{}};
+}
+inline void UnloadRenderTexture(RenderTexture2D) {}
+
+// Dessin : seuls les compteurs changent
+inline void ClearBackground(Color) {}
+inline void BeginMode2D(Camera2D) {}
+inline void EndMode2D() {}
+inline void BeginTextureMode(RenderTexture2D) { NullDraw().layerPasses++; }
+inline void EndTextureMode() {}
+inline void DrawTexturePro(Texture2D, Rectangle, Rectangle dest, Vector2, float, Color) {
+    NullDraw().drawCalls++;
+    NullDraw().pixels += (double)dest.width * dest.height;
+}
+inline void DrawTextureRec(Texture2D, Rectangle source, Vector2, Color) {
+    NullDraw().drawCalls++;
+    NullDraw().pixels += (double)source.width * (source.height < 0 ? -source.height : source.height);
+}
+
+// Audio et fichiers
+inline Music LoadMusicStreamFromMemory(const char*, const unsigned char*, int) { return Music{}; }
+inline void UnloadMusicStream(Music) {}
+inline const char* GetFileExtension(const char* path) { return strrchr(path, '.'); }
+
+// Journal : muet
+inline void TraceLog(int, const char*, ...) {}
+
+#endif
@@ -0,0 +1,208 @@
+#ifndef OBSTACLE_SWARM_H
+#define OBSTACLE_SWARM_H
+
+#include <stdint.h>
+#include <vector>
+#include "maze_grid.h"
+#include "rng.h"
+
+// Comportement d'un obstacle, choisi à sa création
+enum ObstacleBehavior {
+    WANDER,   // Marche aléatoire le long des couloirs (demi-tour seulement dans une impasse)
+    PATROL,   // Suit le mur de droite : parcourt tout le labyrinthe par une ronde régulière
+    CHASE     // Poursuit le joueur par les couloirs quand il est à moins de CHASE_RADIUS pas, erre sinon
+};
+
+// Ensemble des obstacles mobiles d'une partie, de quelques-uns à plusieurs milliers sur les grandes grilles.
+//
+// L'état est rangé par tableaux (une colonne par champ) plutôt qu'un objet par obstacle : le déplacement
+// parcourt des tableaux contigus. Une grille d'occupation compte les obstacles de chaque cellule,
+// la collision avec le joueur se vérifie donc en une seule lecture, quel que soit le nombre d'obstacles.
+// Les obstacles avancent d'une cellule à la fois et ne traversent jamais un mur.
+class ObstacleSwarm {
+public:
+    static const int CHASE_RADIUS = 12;  // Portée de la poursuite (en pas dans le labyrinthe)
+
+private:
+    static const int CHASE_WINDOW = 2 * CHASE_RADIUS + 1;  // Côté de la fenêtre de poursuite centrée sur le joueur
+    static const uint16_t OUT_OF_RANGE = 0xFFFF;            // Cellule hors de portée de la poursuite
+
+    int gridWidth, gridHeight;       // Dimensions du labyrinthe
+    std::vector<int> x, y;           // Position de chaque obstacle
+    std::vector<int> previousX, previousY;  // Position au pas précédent (le dessin interpole entre les deux)
+    std::vector<uint8_t> heading;    // Dernière direction prise (MazeGrid::Direction)
+    std::vector<uint8_t> behavior;   // Comportement (ObstacleBehavior)
+    std::vector<uint16_t> occupancy; // Nombre d'obstacles par cellule
+    int chasers;                     // Nombre d'obstacles qui poursuivent le joueur
+    float moveTimer;                 // Temps écoulé depuis le dernier déplacement
+    bool moved;                      // Vrai si les obstacles se sont déplacés pendant le dernier pas
+    float moveInterval;              // Intervalle entre deux déplacements (en secondes)
+    Rng random;                      // Générateur propre aux obstacles : leurs déplacements sont reproductibles
+
+    // Poursuite : distances au joueur par les couloirs, limitées à CHASE_RADIUS pas,
+    // dans une fenêtre centrée sur le joueur (parcours en largeur borné, recalculé quand le joueur bouge)
+    std::vector<uint16_t> chaseDistance;
+    std::vector<int> chaseQueue;
+    int chaseX, chaseY;              // Position du joueur au dernier calcul (-1 : à calculer)
+
+    // Déplacement d'un pas dans la direction d (MazeGrid::Direction)
+    static int StepX(int d) { return d == MazeGrid::RIGHT ? 1 : (d == MazeGrid::LEFT ? -1 : 0); }
+    static int StepY(int d) { return d == MazeGrid::DOWN ? 1 : (d == MazeGrid::UP ? -1 : 0); }
+
+    uint16_t& Cell(int cellX, int cellY) { return occupancy[(size_t)cellY * gridWidth + cellX]; }
+
+    // Distance au joueur de la cellule (cellX, cellY), OUT_OF_RANGE hors de la fenêtre ou au-delà de la portée
+    uint16_t ChaseDistance(int cellX, int cellY) const {
+        int wx = cellX - (chaseX - CHASE_RADIUS), wy = cellY - (chaseY - CHASE_RADIUS);
+        if (wx < 0 || wx >= CHASE_WINDOW || wy < 0 || wy >= CHASE_WINDOW) return OUT_OF_RANGE;
+        return chaseDistance[wy * CHASE_WINDOW + wx];
+    }
+
+    // Parcours en largeur depuis le joueur, arrêté à CHASE_RADIUS pas (au plus CHASE_WINDOW² cellules)
+    void BuildChaseField(const MazeGrid& grid, int playerX, int playerY) {
+        chaseX = playerX;
+        chaseY = playerY;
+        chaseDistance.assign(CHASE_WINDOW * CHASE_WINDOW, (uint16_t)OUT_OF_RANGE);
+        chaseQueue.clear();
+        int center = CHASE_RADIUS * CHASE_WINDOW + CHASE_RADIUS;
+        chaseDistance[center] = 0;
+        chaseQueue.push_back(center);
+        for (size_t head = 0; head < chaseQueue.size(); head++) {
+            int cell = chaseQueue[head];
+            int wx = cell % CHASE_WINDOW, wy = cell / CHASE_WINDOW;
+            uint16_t next = chaseDistance[cell] + 1;
+            if (next > CHASE_RADIUS) continue;
+            int cellX = chaseX - CHASE_RADIUS + wx, cellY = chaseY - CHASE_RADIUS + wy;
+            for (int d = 0; d < 4; d++) {
+                // La distance de Manhattan ne dépasse jamais le nombre de pas : le voisin reste dans la fenêtre
+                int neighbor = (wy + StepY(d)) * CHASE_WINDOW + wx + StepX(d);
+                if (chaseDistance[neighbor] != OUT_OF_RANGE || grid.HasWall(cellX, cellY, StepX(d), StepY(d))) continue;
+                chaseDistance[neighbor] = next;
+                chaseQueue.push_back(neighbor);
+            }
+        }
+    }
+
+    // Direction d'un pas de marche aléatoire : une ouverture au hasard, sans revenir en arrière sauf dans une impasse
+    int WanderDirection(const MazeGrid& grid, int i) {
+        int back = (heading[i] + 2) & 3;
+        int open[4];
+        int count = 0;
+        for (int d = 0; d < 4; d++) {
+            if (d != back && !grid.HasWall(x[i], y[i], StepX(d), StepY(d))) open[count++] = d;
+        }
+        if (count == 0) return grid.HasWall(x[i], y[i], StepX(back), StepY(back)) ? -1 : back;
+        return open[count == 1 ? 0 : random.Range(0, count - 1)];
+    }
+
+    // Direction d'un pas de ronde : à droite si possible, sinon tout droit, à gauche, puis demi-tour
+    int PatrolDirection(const MazeGrid& grid, int i) {
+        for (int turn : {1, 0, 3, 2}) {
+            int d = (heading[i] + turn) & 3;
+            if (!grid.HasWall(x[i], y[i], StepX(d), StepY(d))) return d;
+        }
+        return -1;
+    }
+
+    // Direction d'un pas de poursuite : vers une voisine plus proche du joueur, sinon marche aléatoire
+    int ChaseDirection(const MazeGrid& grid, int i) {
+        uint16_t distance = ChaseDistance(x[i], y[i]);
+        if (distance != OUT_OF_RANGE && distance > 0) {
+            for (int d = 0; d < 4; d++) {
+                if (ChaseDistance(x[i] + StepX(d), y[i] + StepY(d)) == distance - 1 && !grid.HasWall(x[i], y[i], StepX(d), StepY(d))) return d;
+            }
+        }
+        return WanderDirection(grid, i);
+    }
+
+public:
+    ObstacleSwarm(float interval = 0.25f, uint64_t seed = 0)
+        : gridWidth(0), gridHeight(0), chasers(0), moveTimer(0), moved(false), moveInterval(interval), random(seed), chaseX(-1), chaseY(-1) {}
+
+    // Place count obstacles au hasard dans un labyrinthe de width x height cellules, hors de la cellule
+    // de départ (0, 0) et de la sortie. Les comportements sont attribués à tour de rôle dans l'ordre donné.
+    void Spawn(int count, int width, int height, const std::vector<ObstacleBehavior>& behaviors = {WANDER}) {
+        gridWidth = width;
+        gridHeight = height;
+        occupancy.assign((size_t)width * height, 0);
+        size_t cells = (size_t)width * height;
+        if (cells <= 2 || behaviors.empty()) count = 0;  // Aucune cellule libre hors du départ et de la sortie
+        x.resize(count);
+        y.resize(count);
+        heading.resize(count);
+        behavior.resize(count);
+        chasers = 0;
+        for (int i = 0; i < count; i++) {
+            do {
+                x[i] = random.Range(0, width - 1);
+                y[i] = random.Range(0, height - 1);
+            } while ((x[i] == 0 && y[i] == 0) || (x[i] == width - 1 && y[i] == height - 1));
+            Cell(x[i], y[i])++;
+            heading[i] = (uint8_t)random.Range(0, 3);
+            behavior[i] = (uint8_t)behaviors[i % behaviors.size()];
+            if (behavior[i] == CHASE) chasers++;
+        }
+        previousX = x;
+        previousY = y;
+        moveTimer = 0;
+        moved = false;
+        chaseX = chaseY = -1;
+    }
+
+    // Mémorise les positions de départ du pas, pour l'interpolation du dessin
+    // (rien à copier si les obstacles n'ont pas bougé au pas précédent : les positions sont déjà égales)
+    void BeginStep() {
+        if (!moved) return;
+        previousX = x;
+        previousY = y;
+        moved = false;
+    }
+
+    // Avance chaque obstacle d'une cellule le long d'un couloir ouvert, dt secondes après le pas précédent.
+    // La grille peut changer d'un pas à l'autre (régénération) : seules ses dimensions doivent rester les mêmes.
+    void Move(float dt, const MazeGrid& grid, int playerX, int playerY, bool mazeChanged = false) {
+        moveTimer += dt;
+        if (moveTimer < moveInterval) return;
+        moveTimer = 0;
+        moved = true;
+
+        if (chasers > 0 && (mazeChanged || playerX != chaseX || playerY != chaseY)) BuildChaseField(grid, playerX, playerY);
+
+        for (size_t i = 0; i < x.size(); i++) {
+            int direction;
+            switch (behavior[i]) {
+                case PATROL: direction = PatrolDirection(grid, (int)i); break;
+                case CHASE: direction = ChaseDirection(grid, (int)i); break;
+                default: direction = WanderDirection(grid, (int)i); break;
+            }
+            if (direction < 0) continue;  // Cellule fermée de tous côtés
+
+            Cell(x[i], y[i])--;
+            x[i] += StepX(direction);
+            y[i] += StepY(direction);
+            heading[i] = (uint8_t)direction;
+            Cell(x[i], y[i])++;
+        }
+    }
+
+    // Vrai si au moins un obstacle occupe la cellule (cellX, cellY)
+    bool IsOccupied(int cellX, int cellY) const {
+        return occupancy[(size_t)cellY * gridWidth + cellX] != 0;
+    }
+
+    // Accès en lecture aux positions, pour le dessin
+    int GetCount() const { return (int)x.size(); }
+    int GetX(int i) const { return x[i]; }
+    int GetY(int i) const { return y[i]; }
+    int GetPreviousX(int i) const { return previousX[i]; }
+    int GetPreviousY(int i) const { return previousY[i]; }
+    ObstacleBehavior GetBehavior(int i) const { return (ObstacleBehavior)behavior[i]; }
+
+    // Mémoire occupée par les tableaux et la grille d'occupation (en octets)
+    size_t MemoryBytes() const {
+        return (x.capacity() + y.capacity() + previousX.capacity() + previousY.capacity() + chaseQueue.capacity()) * sizeof(int) +
+               heading.capacity() + behavior.capacity() + (occupancy.capacity() + chaseDistance.capacity()) * sizeof(uint16_t);
+    }
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+#include <chrono>
+
+// Générateur pseudo-aléatoire autonome (xoshiro128**), initialisé par une graine explicite.
+// La même graine donne la même suite de tirages sur toutes les plateformes et tous les compilateurs,
+// contrairement à rand() ou GetRandomValue dont l'état est global et l'implémentation variable.
+// Chaque objet qui tire au hasard possède son propre générateur : aucun état partagé entre threads.
+class Rng {
+private:
+    uint32_t state[4];  // État interne (128 bits)
+    uint64_t seed;      // Graine utilisée à l'initialisation
+
+    static uint32_t Rotl(uint32_t x, int k) {
+        return (x << k) | (x >> (32 - k));
+    }
+
+    // Étape de splitmix64 : répartit les bits d'une graine quelconque (même 0) sur tout l'état
+    static uint64_t SplitMix64(uint64_t& value) {
+        uint64_t z = (value += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    explicit Rng(uint64_t seed = 0) { Seed(seed); }
+
+    // Réinitialise le générateur avec la graine donnée
+    void Seed(uint64_t newSeed) {
+        seed = newSeed;
+        uint64_t mix = newSeed;
+        uint64_t a = SplitMix64(mix);
+        uint64_t b = SplitMix64(mix);
+        state[0] = (uint32_t)a;
+        state[1] = (uint32_t)(a >> 32);
+        state[2] = (uint32_t)b;
+        state[3] = (uint32_t)(b >> 32);
+    }
+
+    // Prochain entier de 32 bits
+    uint32_t Next() {
+        uint32_t result = Rotl(state[1] * 5, 7) * 9;
+        uint32_t t = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = Rotl(state[3], 11);
+        return result;
+    }
+
+    // Prochain entier de 64 bits (utilisé pour tirer des graines)
+    uint64_t Next64() {
+        uint64_t high = Next();
+        return (high << 32) | Next();
+    }
+
+    // Entier uniforme entre min et max inclus (mêmes bornes que GetRandomValue de raylib).
+    // Multiplication 32 x 32 -> 64 bits au lieu d'un modulo : pas de division dans la boucle de génération.
+    int Range(int min, int max) {
+        uint32_t span = (uint32_t)(max - min) + 1;
+        return min + (int)(((uint64_t)Next() * span) >> 32);
+    }
+
+    // Graine utilisée à l'initialisation
+    uint64_t GetSeed() const { return seed; }
+
+    // Graine tirée de l'horloge, pour une partie qui n'a pas reçu de graine explicite
+    static uint64_t SeedFromClock() {
+        uint64_t ticks = (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+        return SplitMix64(ticks);
+    }
+};
+
+#endif
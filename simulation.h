@@ -0,0 +1,513 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+// Cœur de simulation du jeu, indépendant de raylib : labyrinthe, joueur, obstacles et chronomètres
+// avancent par un pas de temps explicite et une structure de commandes, sans fenêtre ni clavier.
+// Le jeu (main.cpp) se contente de lire les entrées, d'appeler Step() et de dessiner l'état.
+
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+#include "maze_grid.h"
+#include "maze_generators.h"
+#include "tiled_maze.h"
+#include "chunked_maze.h"
+#include "distance_field.h"
+#include "obstacle_swarm.h"
+#include "difficulty.h"
+#include "job_system.h"
+#include "wall_mesh.h"
+
+class Position {  // Définition d'une classe représentant une position avec des coordonnées x et y
+public:
+    int x, y;  // Déclaration des variables membres x et y représentant la position
+
+    // Constructeur qui initialise les valeurs x et y à 0 par défaut, mais peut être modifié avec des valeurs spécifiques
+    Position(int x = 0, int y = 0) : x(x), y(y) {}
+};
+
+class Niveau {
+public:
+    enum Level { FACILE, MOYEN, DIFFICILE };  // Définition d'un énuméré pour les trois niveaux de difficulté
+    Level niveau;  // Variable membre qui représente le niveau actuel
+
+    // Constructeur qui initialise le niveau à MOYEN par défaut, mais permet de définir un autre niveau si nécessaire
+    Niveau(Level level = MOYEN) : niveau(level) {}
+
+    // Fonction qui retourne la densité des obstacles en fonction du niveau choisi
+    float getObstacleDensity() {
+        switch (niveau) {
+            case FACILE: return 0.3f;   // Pour le niveau facile, la densité des obstacles est de 30%
+            case MOYEN: return 0.5f;    // Pour le niveau moyen, la densité des obstacles est de 50%
+            case DIFFICILE: return 0.7f; // Pour le niveau difficile, la densité des obstacles est de 70%
+        }
+        return 0.0f;
+    }
+
+    // Nombre d'obstacles d'un labyrinthe de width x height cellules : la densité est exprimée en obstacles
+    // pour 100 cellules (un obstacle au niveau moyen sur la grille du jeu, des milliers sur les grandes grilles)
+    int getObstacleCount(int width, int height) {
+        return (int)(getObstacleDensity() * width * height / 100.0);
+    }
+
+    // Comportements des obstacles, attribués à tour de rôle : au niveau facile ils errent,
+    // au niveau moyen ils font aussi des rondes, au niveau difficile certains poursuivent le joueur
+    std::vector<ObstacleBehavior> getObstacleBehaviors() {
+        switch (niveau) {
+            case FACILE: return {WANDER};
+            case MOYEN: return {PATROL, WANDER};
+            case DIFFICILE: return {CHASE, PATROL, WANDER};
+        }
+        return {WANDER};
+    }
+
+    // Algorithme de génération du niveau : Prim donne de nombreuses impasses courtes et un chemin direct,
+    // l'arbre croissant un compromis, le backtracker de longs couloirs et le chemin le plus long
+    MazeAlgorithm getAlgorithm() {
+        switch (niveau) {
+            case FACILE: return PRIM;
+            case MOYEN: return GROWING_TREE;
+            case DIFFICILE: return BACKTRACKER;
+        }
+        return BACKTRACKER;
+    }
+
+    // Difficulté visée des labyrinthes du niveau, d'après les distributions mesurées par maze_eval sur la grille du jeu :
+    // au niveau facile une solution presque directe, au niveau moyen un détour marqué, au niveau difficile
+    // une longue solution et de longs couloirs avec peu d'impasses
+    DifficultyTarget getDifficultyTarget() {
+        switch (niveau) {
+            case FACILE: return DifficultyTarget{1.0, 1.25, 0.25, 0.36};
+            case MOYEN: return DifficultyTarget{1.4, 2.0, 0.20, 0.32};
+            case DIFFICILE: return DifficultyTarget{2.5, 4.0, 0.08, 0.14};
+        }
+        return DifficultyTarget::Any();
+    }
+
+    // Fonction qui indique si le niveau est dynamique (seulement le niveau difficile est dynamique)
+    bool isDynamic() {
+        return niveau == DIFFICILE; // Si le niveau est difficile, la fonction retourne true, sinon false
+    }
+};
+
+// Labyrinthe de la simulation : grille, segments de murs et régénération en arrière-plan
+class Maze {
+private:
+    MazeGrid grid;                         // Grille de cellules représentant le labyrinthe
+    mutable WallMesh wallMesh;             // Segments de murs fusionnés, reconstruits après chaque génération
+    mutable bool meshDirty;                // Segments à reconstruire à la prochaine lecture (après une re-génération locale)
+    DistanceField distanceField;           // Distances vers la sortie (width - 1, height - 1), recalculées après chaque génération
+    int gridWidth, gridHeight;             // Dimensions du labyrinthe
+    unsigned generation;                   // Incrémenté à chaque changement des murs (sert à invalider les caches de dessin)
+    MazeId id;                             // Identifiant du labyrinthe affiché (graine, taille, algorithme)
+    Position startCell;                    // Cellule de départ de sa génération ((-1, -1) : tirée de la graine)
+    Rng seeds;                             // Suite des graines des labyrinthes suivants (régénérations)
+    TiledMazeGenerator generator;          // Générateur utilisé sur le thread appelant (par tuiles au-delà de 256x256)
+    MazeGenerator regionGenerator;         // Générateur des re-générations locales (tampons de la taille de la fenêtre)
+    DifficultyTarget target;               // Difficulté visée après chaque génération complète
+    DifficultyTuner tuner;                 // Mise au point des labyrinthes générés sur le thread appelant
+    DifficultyReport lastTuning;           // Résultat de la dernière mise au point
+
+    // Régénération en arrière-plan : le prochain labyrinthe est construit dans un tampon arrière
+    // par un thread de travail, puis échangé avec le labyrinthe affiché en une seule opération
+    MazeGrid backGrid;                     // Tampon arrière de la grille
+    WallMesh backMesh;                     // Segments de murs du tampon arrière
+    DistanceField backField;               // Distances vers la sortie du tampon arrière
+    DifficultyTuner backTuner;             // Mise au point propre au thread de travail
+    DifficultyReport backTuning;           // Résultat de la mise au point du tampon arrière
+    MazeId backId;                         // Identifiant du labyrinthe du tampon arrière
+    Position backStartCell;                // Cellule de départ de sa génération
+    TiledMazeGenerator backGenerator;      // Générateur propre au thread de travail (tampons non partagés)
+    JobFuture<double> pendingRegeneration; // Construction en cours (renvoie sa durée en millisecondes)
+    float lastBuildMs;                     // Durée de la dernière construction en arrière-plan
+    float lastSwapMs;                      // Durée du dernier échange sur le thread principal
+
+    // Amène le labyrinthe généré à la difficulté visée ; les réparations sont tirées de la graine du labyrinthe,
+    // l'identifiant redonne donc le même labyrinthe (tant que la mise au point tient dans son budget)
+    void Tune(DifficultyTuner& difficultyTuner, MazeGrid& mazeGrid, const MazeId& mazeId, DifficultyReport& report) {
+        report = DifficultyReport{true, 0, 0, 0.0, 0.0f};
+        if (target.IsAny()) return;
+        Rng random(mazeId.seed ^ 0x9E3779B97F4A7C15ULL);
+        report = difficultyTuner.Tune(mazeGrid, target, random);
+    }
+
+    // Identifiant du prochain labyrinthe : même taille et même algorithme, graine suivante de la suite
+    MazeId NextId() {
+        MazeId next = id;
+        next.seed = seeds.Next64();
+        return next;
+    }
+
+public:
+    // Constructeur qui génère un premier labyrinthe aux dimensions choisies avec l'algorithme donné.
+    // Ce labyrinthe a pour graine seed ; les régénérations suivantes tirent leurs graines d'une suite issue de seed.
+    // Chaque labyrinthe généré en entier est ensuite mis au point vers la difficulté visée (aucune par défaut).
+    Maze(int width, int height, uint64_t seed = 0, MazeAlgorithm algorithm = BACKTRACKER,
+         const DifficultyTarget& difficulty = DifficultyTarget::Any())
+        : grid(width, height), meshDirty(false), gridWidth(width), gridHeight(height), generation(0), seeds(seed),
+          target(difficulty), backGrid(width, height), lastBuildMs(0), lastSwapMs(0) {
+        Load(MazeId{seed, width, height, algorithm});
+    }
+
+    // Destructeur qui attend la fin d'une éventuelle construction en arrière-plan
+    ~Maze() {
+        CancelRegeneration();
+    }
+
+    // Génère le labyrinthe identifié par newId à partir de la cellule from, tirée de la graine par défaut
+    // (mêmes murs, bit pour bit, que lors de sa première génération avec la même cellule de départ)
+    void Load(const MazeId& newId, Position from = Position(-1, -1)) {
+        CancelRegeneration();  // Une régénération en arrière-plan en cours n'a plus lieu d'être
+        id = newId;
+        startCell = from;
+        gridWidth = id.width;
+        gridHeight = id.height;
+        generator.Generate(grid, id, startCell.x, startCell.y);
+        Tune(tuner, grid, id, lastTuning);
+        wallMesh.Build(grid);  // Fusionne les murs en segments après chaque génération
+        meshDirty = false;
+        distanceField.Build(grid, gridWidth - 1, gridHeight - 1);
+        generation++;  // Les murs ont changé
+    }
+
+    // Remplace le labyrinthe par des murs déjà construits (lus dans un paquet de niveaux, maze_file.h : Simulation::LoadFixedMaze) ;
+    // ils sont repris tels quels, sans mise au point
+    void Load(const MazeId& newId, const MazeGrid& walls) {
+        CancelRegeneration();
+        id = newId;
+        startCell = Position(-1, -1);
+        gridWidth = id.width;
+        gridHeight = id.height;
+        grid = walls;
+        lastTuning = DifficultyReport{true, 0, 0, 0.0, 0.0f};
+        wallMesh.Build(grid);
+        meshDirty = false;
+        distanceField.Build(grid, gridWidth - 1, gridHeight - 1);
+        generation++;
+    }
+
+    // Initialise toutes les cellules du labyrinthe avec des murs et non visitées
+    void InitializeMaze() {
+        grid.Reset();  // Remet tous les murs et marque toutes les cellules comme non visitées
+        meshDirty = true;
+        generation++;  // Les caches de dessin doivent être reconstruits
+    }
+
+    // Regénère immédiatement le labyrinthe avec la graine suivante, à partir de la cellule from (en jeu, celle du joueur)
+    void Regenerate(Position from = Position(-1, -1)) {
+        Load(NextId(), from);
+    }
+
+    // Re-génère seulement la fenêtre de size x size cellules centrée sur (centerX, centerY) ; le reste du labyrinthe
+    // ne change pas et l'ensemble reste un labyrinthe parfait. Le coût dépend de la taille de la fenêtre :
+    // les distances vers la sortie ne sont recalculées que dans la fenêtre, et les segments de murs
+    // complets ne sont reconstruits qu'à leur prochaine lecture (le mode caméra ne les lit pas).
+    // L'identifiant reste celui du labyrinthe de départ ; les graines des fenêtres sont tirées de la même suite.
+    void RegenerateRegion(int centerX, int centerY, int size) {
+        CancelRegeneration();
+        auto start = std::chrono::steady_clock::now();
+        int x0 = std::max(0, std::min(centerX - size / 2, gridWidth - size));
+        int y0 = std::max(0, std::min(centerY - size / 2, gridHeight - size));
+        int x1 = std::min(gridWidth, x0 + size);
+        int y1 = std::min(gridHeight, y0 + size);
+
+        Rng random(seeds.Next64());
+        regionGenerator.RegenerateRegion(grid, x0, y0, x1, y1, random, gridWidth - 1, gridHeight - 1);
+        distanceField.UpdateRegion(grid, x0, y0, x1, y1);
+        meshDirty = true;
+        generation++;
+        lastBuildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        lastSwapMs = 0;
+    }
+
+    // Lance la construction du prochain labyrinthe (graine suivante) sur le pool de threads partagé,
+    // à partir de la cellule from (en jeu, celle du joueur au moment de la demande).
+    // Sans effet si une construction est déjà en cours.
+    void RequestRegenerate(Position from = Position(-1, -1)) {
+        if (pendingRegeneration.Valid()) return;
+        backId = NextId();  // Tirée sur le thread appelant : la suite des graines ne dépend pas du thread
+        backStartCell = from;
+        pendingRegeneration = JobFuture<double>::Async([this]() {
+            auto start = std::chrono::steady_clock::now();
+            backGenerator.Generate(backGrid, backId, backStartCell.x, backStartCell.y);  // Générateur et tirages propres au thread de travail
+            Tune(backTuner, backGrid, backId, backTuning);
+            backMesh.Build(backGrid);  // Les segments et les distances sont aussi préparés hors du thread principal
+            backField.Build(backGrid, backId.width - 1, backId.height - 1);
+            return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        });
+    }
+
+    // Échange le labyrinthe courant avec le tampon arrière si sa construction est terminée.
+    // Retourne true si le labyrinthe a changé.
+    bool SwapRegenerated() {
+        if (!pendingRegeneration.IsReady()) return false;
+
+        auto start = std::chrono::steady_clock::now();
+        lastBuildMs = (float)pendingRegeneration.Get();
+        std::swap(grid, backGrid);  // Échange des tampons : aucune copie de la grille
+        std::swap(wallMesh, backMesh);
+        meshDirty = false;  // Le tampon arrière vient d'être construit en entier
+        std::swap(distanceField, backField);
+        std::swap(id, backId);
+        std::swap(startCell, backStartCell);
+        std::swap(lastTuning, backTuning);
+        generation++;  // Les caches de dessin seront reconstruits à la prochaine image
+        lastSwapMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    // Attend et abandonne une éventuelle construction en arrière-plan
+    void CancelRegeneration() {
+        if (pendingRegeneration.Valid()) pendingRegeneration.Get();
+    }
+
+    // Durées de la dernière régénération en arrière-plan ou locale (en millisecondes)
+    float GetLastBuildMs() const { return lastBuildMs; }
+    float GetLastSwapMs() const { return lastSwapMs; }
+
+    // Vérifie s'il y a un mur dans la direction donnée par dx et dy
+    bool HasWall(Position player, int dx, int dy) const {
+        return grid.HasWall(player.x, player.y, dx, dy);
+    }
+
+    // Accès en lecture à la grille, aux segments de murs, aux distances vers la sortie et au compteur de modifications
+    const MazeGrid& GetGrid() const { return grid; }
+    const WallMesh& GetWallMesh() const {
+        if (meshDirty) {
+            wallMesh.Build(grid);
+            meshDirty = false;
+        }
+        return wallMesh;
+    }
+    const DistanceField& GetDistanceField() const { return distanceField; }
+    unsigned GetGeneration() const { return generation; }
+    const DifficultyTarget& GetDifficultyTarget() const { return target; }
+    const DifficultyReport& GetLastTuning() const { return lastTuning; }
+    const MazeId& GetId() const { return id; }
+    Position GetStart() const { return startCell; }
+
+    // Accesseurs pour obtenir la largeur et la hauteur du labyrinthe
+    int GetGridWidth() const { return gridWidth; }
+    int GetGridHeight() const { return gridHeight; }
+};
+
+class Player {
+public:
+    Position position;            // Position actuelle du joueur dans le labyrinthe
+    Position previousPosition;    // Position au pas précédent (le dessin interpole entre les deux)
+    int gridWidth, gridHeight;    // Dimensions dynamiques du labyrinthe
+
+    // Constructeur initialisant la position du joueur
+    Player(int x = 0, int y = 0, int width = 1, int height = 1)
+        : position(x, y), previousPosition(x, y), gridWidth(width), gridHeight(height) {}
+
+    // Définir la taille du labyrinthe pour le joueur
+    void SetGridSize(int width, int height) {
+        gridWidth = width;
+        gridHeight = height;
+    }
+
+    // Fonction pour déplacer le joueur
+    void Move(int dx, int dy, const Maze &maze, bool &gameWon) {
+        int newX = position.x + dx;
+        int newY = position.y + dy;
+
+        // Vérifie que le nouveau déplacement est à l'intérieur du labyrinthe
+        if (newX < 0 || newX >= gridWidth || newY < 0 || newY >= gridHeight) return;
+
+        // Vérifie si un mur bloque le déplacement
+        if (maze.HasWall(position, dx, dy)) return;
+
+        // Met à jour la position du joueur
+        position.x = newX;
+        position.y = newY;
+
+        // Vérifie si le joueur a atteint la sortie
+        if (position.x == gridWidth - 1 && position.y == gridHeight - 1) gameWon = true;
+    }
+};
+
+// Commandes appliquées pendant un pas de simulation
+struct SimInput {
+    bool right, left, up, down;  // Déplacements demandés (une case par direction)
+    bool togglePause;            // Alterner entre pause et reprise
+    bool reset;                  // Recommencer le labyrinthe
+
+    SimInput() : right(false), left(false), up(false), down(false), togglePause(false), reset(false) {}
+};
+
+// État complet d'une partie, avancé par Step() sans aucune dépendance à raylib
+class Simulation {
+public:
+    Niveau niveau;      // Niveau de difficulté
+    Maze maze;          // Le labyrinthe
+    Player player;      // Le joueur (Tom)
+    ObstacleSwarm obstacles; // Les obstacles mobiles, en nombre fixé par la densité du niveau
+    Position goal;      // La position de l'objectif (Jerry)
+    bool gameWon;       // Indicateur si le jeu est gagné
+    bool isPaused;      // Indicateur si le jeu est en pause
+    float timer;        // Chronomètre de la partie
+    float changeTimer;  // Timer pour régénérer le labyrinthe (niveau difficile)
+    bool mazeChanged;   // Vrai si le dernier pas a remplacé le labyrinthe
+    bool asyncRegeneration; // Régénération sur un thread de travail (jeu) ou immédiate (simulation accélérée)
+    int regionSize;     // Côté de la fenêtre re-générée autour du joueur au niveau difficile (0 : tout le labyrinthe)
+    bool fixedMaze;     // Labyrinthe lu dans un paquet de niveaux : gardé toute la partie, jamais re-généré
+
+    // Intervalle entre deux régénérations du labyrinthe au niveau difficile (en secondes)
+    static constexpr float CHANGE_INTERVAL = 3.0f;
+
+    // Au-delà de LOCAL_REGENERATION_CELLS cellules, le niveau difficile ne re-génère qu'une fenêtre
+    // de REGION_SIZE x REGION_SIZE cellules autour du joueur (la partie visible en mode caméra), et les labyrinthes
+    // ne sont plus mis au point vers la difficulté du niveau (une seule analyse dépasserait le budget d'une image)
+    static const int REGION_SIZE = 16;
+    static const int LOCAL_REGENERATION_CELLS = 64 * 64;
+
+    // La graine détermine toute la partie : premier labyrinthe, régénérations, placement et déplacements des obstacles
+    Simulation(Niveau::Level level, int width, int height, uint64_t seed = 0)
+        : Simulation(level, width, height, seed, Niveau(level).getAlgorithm()) {}
+
+    // Partie dont les labyrinthes sont générés par un autre algorithme que celui du niveau (évaluation des niveaux).
+    // tuned = false : labyrinthes tels que le générateur les produit, sans mise au point vers la difficulté du niveau
+    Simulation(Niveau::Level level, int width, int height, uint64_t seed, MazeAlgorithm algorithm, bool tuned = true)
+        : niveau(level),
+          maze(width, height, seed, algorithm,
+               tuned && width * height <= LOCAL_REGENERATION_CELLS ? niveau.getDifficultyTarget() : DifficultyTarget::Any()),
+          player(0, 0, width, height),
+          obstacles(0.25f, seed + 1), goal(width - 1, height - 1),
+          gameWon(false), isPaused(false), timer(0), changeTimer(0), mazeChanged(false), asyncRegeneration(true),
+          regionSize(width * height > LOCAL_REGENERATION_CELLS ? REGION_SIZE : 0), fixedMaze(false) {
+        obstacles.Spawn(niveau.getObstacleCount(width, height), width, height, niveau.getObstacleBehaviors());
+    }
+
+    // Remet la partie au début sans changer de labyrinthe
+    void Initialize() {
+        player.position = Position(0, 0);  // Placer le joueur au début du labyrinthe
+        player.previousPosition = player.position;  // Pas de glissement depuis l'ancienne position
+        gameWon = false;  // Le jeu n'est pas gagné au début
+        timer = 0;  // Réinitialiser le chronomètre
+        changeTimer = 0;  // Réinitialiser le timer de régénération du labyrinthe
+        player.SetGridSize(maze.GetGridWidth(), maze.GetGridHeight());
+    }
+
+    // Joue les murs donnés (labyrinthe lu dans un paquet de niveaux, maze_file.h) à la place du labyrinthe généré.
+    // Ils doivent avoir les dimensions de la partie. Ils sont gardés jusqu'à la fin de la partie : ni régénération
+    // au niveau difficile, ni nouveau labyrinthe à la réinitialisation.
+    void LoadFixedMaze(const MazeId& id, const MazeGrid& walls) {
+        maze.Load(id, walls);
+        fixedMaze = true;
+        Initialize();
+        mazeChanged = true;
+    }
+
+    // Remet la partie au début avec un nouveau labyrinthe (le même pour un labyrinthe d'un paquet)
+    void Reset() {
+        Initialize();
+        if (!fixedMaze) maze.Regenerate(player.position);  // Régénérer le labyrinthe à partir du départ du joueur
+        mazeChanged = true;
+    }
+
+    // Avance la partie de dt secondes en appliquant les commandes données.
+    // Le jeu l'appelle avec un pas fixe : la vitesse des obstacles ne dépend plus de la fréquence d'affichage.
+    void Step(float dt, const SimInput& input) {
+        mazeChanged = false;
+        player.previousPosition = player.position;  // État de départ du pas, pour l'interpolation du dessin
+        obstacles.BeginStep();
+        if (gameWon) return;
+
+        if (input.togglePause) isPaused = !isPaused;  // Alterner entre pause et reprise
+        if (input.reset) Reset();
+        if (isPaused) return;  // Rien n'avance pendant la pause
+
+        // Si le niveau est dynamique, régénérer le labyrinthe toutes les CHANGE_INTERVAL secondes
+        if (niveau.isDynamic() && !fixedMaze) {
+            changeTimer += dt;
+            if (changeTimer >= CHANGE_INTERVAL && regionSize > 0) {
+                // Grand labyrinthe : seule la fenêtre autour du joueur change, sur place
+                maze.RegenerateRegion(player.position.x, player.position.y, regionSize);
+                changeTimer = 0;
+                mazeChanged = true;
+            } else if (changeTimer >= CHANGE_INTERVAL && !asyncRegeneration) {
+                // Simulation plus rapide que le temps réel : on n'attend pas un thread de travail
+                maze.Regenerate(player.position);
+                changeTimer = 0;
+                mazeChanged = true;
+            } else if (changeTimer >= CHANGE_INTERVAL) {
+                // Le prochain labyrinthe est construit en arrière-plan
+                maze.RequestRegenerate(player.position);  // Le nouveau labyrinthe part de la cellule du joueur
+            }
+            if (maze.SwapRegenerated()) {  // Échange dès que la construction est terminée
+                player.SetGridSize(maze.GetGridWidth(), maze.GetGridHeight());
+                changeTimer = 0;
+                mazeChanged = true;
+            }
+        }
+
+        // Les obstacles se déplacent et renvoient le joueur au départ s'il en touche un
+        obstacles.Move(dt, maze.GetGrid(), player.position.x, player.position.y, mazeChanged);
+        if (obstacles.IsOccupied(player.position.x, player.position.y)) {
+            player.position = Position(0, 0);  // Réinitialiser la position du joueur
+            player.previousPosition = player.position;  // Téléportation : pas d'interpolation
+        }
+
+        // Déplacements du joueur
+        if (input.right) player.Move(1, 0, maze, gameWon);
+        if (input.left) player.Move(-1, 0, maze, gameWon);
+        if (input.up) player.Move(0, -1, maze, gameWon);
+        if (input.down) player.Move(0, 1, maze, gameWon);
+
+        timer += dt;  // Mettre à jour le chronomètre
+    }
+};
+
+// Partie sans fin : le joueur avance librement dans un labyrinthe infini généré par blocs autour de lui.
+// La mémoire reste bornée par la réserve de blocs, quelle que soit la distance parcourue.
+class EndlessSimulation {
+public:
+    ChunkedMaze maze;           // Labyrinthe infini
+    Position player;            // Position du joueur (coordonnées du monde, éventuellement négatives)
+    Position previousPosition;  // Position au pas précédent (le dessin interpole entre les deux)
+    bool isPaused;              // Indicateur si le jeu est en pause
+    float timer;                // Chronomètre de la partie
+    int farthest;               // Plus grande distance atteinte depuis le départ (en cellules, distance de Manhattan)
+
+    // Les blocs à moins de PREFETCH_RADIUS cellules du joueur sont générés avant qu'il ne les atteigne
+    static const int PREFETCH_RADIUS = ChunkedMaze::CHUNK_SIZE;
+
+    EndlessSimulation(uint64_t seed, MazeAlgorithm algorithm = BACKTRACKER, int maxChunks = 64)
+        : maze(seed, algorithm, maxChunks), isPaused(false), timer(0), farthest(0) {
+        maze.Prefetch(0, 0, PREFETCH_RADIUS);
+    }
+
+    // Avance la partie de dt secondes en appliquant les commandes données
+    void Step(float dt, const SimInput& input) {
+        previousPosition = player;
+        if (input.togglePause) isPaused = !isPaused;
+        if (input.reset) {
+            player = previousPosition = Position(0, 0);
+            timer = 0;
+            farthest = 0;
+        }
+        if (isPaused) return;
+
+        if (input.right) Move(1, 0);
+        if (input.left) Move(-1, 0);
+        if (input.up) Move(0, -1);
+        if (input.down) Move(0, 1);
+
+        maze.Prefetch(player.x, player.y, PREFETCH_RADIUS);
+        timer += dt;
+    }
+
+private:
+    // Déplace le joueur d'une case si aucun mur ne bloque le passage (il n'y a pas de bord)
+    void Move(int dx, int dy) {
+        if (maze.HasWall(player.x, player.y, dx, dy)) return;
+        player.x += dx;
+        player.y += dy;
+        farthest = std::max(farthest, std::abs(player.x) + std::abs(player.y));
+    }
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef TILED_MAZE_H
+#define TILED_MAZE_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "job_system.h"
+#include "maze_grid.h"
+#include "maze_generators.h"
+#include "rng.h"
+
+// Génération d'un grand labyrinthe sur plusieurs cœurs.
+//
+// La grille est découpée en tuiles carrées de TILE_SIZE cellules (multiple de 64), générées en parallèle :
+// chaque tuile est un labyrinthe parfait, construit dans une petite grille propre au thread puis recopiée
+// mot par mot. Les tuiles commençant sur un mot de 64 bits, deux tuiles n'écrivent jamais dans le même mot.
+// Les tuiles sont ensuite reliées par un arbre couvrant (un petit labyrinthe dont chaque cellule est une tuile) :
+// une seule porte par arête de l'arbre, le résultat reste donc un labyrinthe parfait.
+//
+// Les tuiles sont réparties en travaux sur le pool partagé (job_system.h) ; le thread appelant en génère aussi.
+// Les graines des tuiles et des portes sont tirées avant la répartition du travail :
+// le labyrinthe ne dépend que de son identifiant, pas du nombre de threads.
+// Une grille qui tient dans une seule tuile est générée directement, comme par MazeGenerator.
+class TiledMazeGenerator {
+public:
+    static const int TILE_SIZE = 256;  // Côté d'une tuile (en cellules), multiple de 64
+
+private:
+    // Espace de travail d'un thread : son générateur et la grille de la tuile en cours
+    struct Worker {
+        MazeGenerator generator;
+        MazeGrid tile;
+    };
+
+    int threadCount;               // Nombre de travaux en parallèle (thread appelant compris)
+    std::vector<Worker> workers;   // Un espace de travail par travail, conservé d'une génération à l'autre
+    std::vector<uint64_t> seeds;   // Graine de chaque tuile
+    MazeGrid tileGraph;            // Arbre couvrant des tuiles
+
+    // Génère les tuiles d'indice tiré du compteur partagé jusqu'à épuisement ; la tuile qui contient
+    // la cellule (startX, startY) est générée à partir de cette cellule
+    void GenerateTiles(Worker& worker, MazeGrid& grid, const MazeId& id, int startX, int startY, int columns, int rows,
+                       std::atomic<int>& next) {
+        int tile = TILE_SIZE;  // Copie de la constante : std::min la prend par référence
+        for (int index = next++; index < columns * rows; index = next++) {
+            int x0 = (index % columns) * TILE_SIZE;
+            int y0 = (index / columns) * TILE_SIZE;
+            int width = std::min(tile, id.width - x0);
+            int height = std::min(tile, id.height - y0);
+            bool start = startX >= x0 && startX < x0 + width && startY >= y0 && startY < y0 + height;
+            worker.generator.Generate(worker.tile, MazeId{seeds[index], width, height, id.algorithm},
+                                      start ? startX - x0 : -1, start ? startY - y0 : -1);
+            grid.CopyTile(worker.tile, x0, y0);
+        }
+    }
+
+public:
+    // threads = 0 : autant de travaux que de threads du pool, thread appelant compris
+    explicit TiledMazeGenerator(int threads = 0) {
+        SetThreadCount(threads);
+    }
+
+    void SetThreadCount(int threads) {
+        if (threads <= 0) threads = Jobs().GetWorkerCount() + 1;
+        threadCount = std::max(threads, 1);
+        workers.resize(threadCount);
+    }
+
+    int GetThreadCount() const { return threadCount; }
+
+    // Génère le labyrinthe identifié par id à partir de la cellule (startX, startY), tirée de la graine si startX < 0
+    // (mêmes murs quel que soit le nombre de threads)
+    void Generate(MazeGrid& grid, const MazeId& id, int startX = -1, int startY = -1) {
+        if (id.width <= TILE_SIZE && id.height <= TILE_SIZE) {
+            workers[0].generator.Generate(grid, id, startX, startY);
+            return;
+        }
+        if (id.width != grid.GetWidth() || id.height != grid.GetHeight()) grid.Resize(id.width, id.height);
+        else grid.Reset();
+
+        int columns = (id.width + TILE_SIZE - 1) / TILE_SIZE;
+        int rows = (id.height + TILE_SIZE - 1) / TILE_SIZE;
+        Rng random(id.seed);
+        seeds.resize((size_t)columns * rows);
+        for (uint64_t& seed : seeds) seed = random.Next64();
+
+        // Tuiles : le thread appelant travaille aussi, les autres travaux sont soumis au pool
+        std::atomic<int> next(0);
+        int helpers = std::min(threadCount, columns * rows) - 1;
+        JobFence fence;
+        for (int i = 1; i <= helpers; i++) {
+            Jobs().Submit(fence, [this, i, &grid, &id, startX, startY, columns, rows, &next]() {
+                GenerateTiles(workers[i], grid, id, startX, startY, columns, rows, next);
+            });
+        }
+        GenerateTiles(workers[0], grid, id, startX, startY, columns, rows, next);
+        Jobs().Wait(fence);
+
+        // Raccord : un arbre couvrant des tuiles, puis une porte tirée au hasard sur chaque frontière de l'arbre
+        workers[0].generator.Generate(tileGraph, MazeId{random.Next64(), columns, rows, KRUSKAL});
+        for (int ty = 0; ty < rows; ty++) {
+            for (int tx = 0; tx < columns; tx++) {
+                int x0 = tx * TILE_SIZE;
+                int y0 = ty * TILE_SIZE;
+                if (tx + 1 < columns && !tileGraph.HasWall(tx, ty, 1, 0)) {
+                    int y = random.Range(y0, std::min(y0 + TILE_SIZE, id.height) - 1);
+                    grid.RemoveWall(x0 + TILE_SIZE - 1, y, MazeGrid::RIGHT);
+                }
+                if (ty + 1 < rows && !tileGraph.HasWall(tx, ty, 0, 1)) {
+                    int x = random.Range(x0, std::min(x0 + TILE_SIZE, id.width) - 1);
+                    grid.RemoveWall(x, y0 + TILE_SIZE - 1, MazeGrid::DOWN);
+                }
+            }
+        }
+    }
+
+    // Mémoire réservée par les espaces de travail (en octets)
+    size_t ScratchBytes() const {
+        size_t bytes = seeds.capacity() * sizeof(uint64_t) + tileGraph.MemoryBytes();
+        for (const Worker& worker : workers) {
+            bytes += worker.generator.ScratchBytes() + worker.tile.MemoryBytes() + worker.tile.ScratchBytes();
+        }
+        return bytes;
+    }
+};
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef WALL_MESH_H
+#define WALL_MESH_H
+
+#include <vector>
+#include "maze_grid.h"
+
+// Segment de mur continu, en coordonnées d'arêtes de la grille.
+// Horizontal : de (x, y) à (x + length, y), sur la ligne au-dessus de la rangée y.
+// Vertical : de (x, y) à (x, y + length), sur la colonne à gauche de la colonne x.
+struct WallRun {
+    int x, y;         // Point de départ du segment
+    int length;       // Longueur en nombre de cellules
+    bool horizontal;  // Orientation du segment
+};
+
+// Liste des murs à dessiner, construite après la génération :
+// chaque mur partagé n'apparaît qu'une fois et les murs alignés consécutifs sont fusionnés.
+class WallMesh {
+private:
+    std::vector<WallRun> runs;  // Segments fusionnés
+    int cellSegments;           // Nombre de quads qu'un dessin cellule par cellule aurait émis
+
+public:
+    WallMesh() : cellSegments(0) {}
+
+    // Reconstruit les segments à partir des plans de murs de la grille
+    void Build(const MazeGrid& grid) {
+        Build(grid, 0, 0, grid.GetWidth(), grid.GetHeight());
+    }
+
+    // Reconstruit uniquement les segments qui bordent les cellules [x0, x1) x [y0, y1).
+    // Le coût dépend de la taille de la fenêtre et non de celle de la grille (utilisé pour le mode caméra).
+    // Sans farEdges, les murs du bas et de droite de la fenêtre sont omis : ils appartiennent à la fenêtre
+    // voisine (blocs accolés du mode sans fin, où chaque mur partagé ne doit être dessiné qu'une fois).
+    void Build(const MazeGrid& grid, int x0, int y0, int x1, int y1, bool farEdges = true) {
+        int width = grid.GetWidth();
+        int height = grid.GetHeight();
+        runs.clear();
+        cellSegments = 0;
+        int lastRow = farEdges ? y1 : y1 - 1;
+        int lastColumn = farEdges ? x1 : x1 - 1;
+
+        // Murs horizontaux : une ligne d'arêtes par rangée, plus la bordure du bas
+        for (int y = y0; y <= lastRow; y++) {
+            int perCell = (y == 0 || y == height) ? 1 : 2;  // Un mur intérieur était dessiné par ses deux cellules
+            int start = -1;
+            for (int x = x0; x <= x1; x++) {
+                bool wall = x < x1 && grid.HasHorizontalWall(x, y);
+                if (wall) {
+                    cellSegments += perCell;
+                    if (start < 0) start = x;  // Début d'un nouveau segment
+                } else if (start >= 0) {
+                    runs.push_back({start, y, x - start, true});  // Fin du segment courant
+                    start = -1;
+                }
+            }
+        }
+
+        // Murs verticaux : une colonne d'arêtes par colonne de cellules, plus la bordure droite
+        for (int x = x0; x <= lastColumn; x++) {
+            int perCell = (x == 0 || x == width) ? 1 : 2;
+            int start = -1;
+            for (int y = y0; y <= y1; y++) {
+                bool wall = y < y1 && grid.HasVerticalWall(x, y);
+                if (wall) {
+                    cellSegments += perCell;
+                    if (start < 0) start = y;
+                } else if (start >= 0) {
+                    runs.push_back({x, start, y - start, false});
+                    start = -1;
+                }
+            }
+        }
+    }
+
+    const std::vector<WallRun>& GetRuns() const { return runs; }
+
+    // Nombre d'appels de dessin avant et après fusion, et différence entre les deux
+    int GetCellSegments() const { return cellSegments; }
+    int GetRunCount() const { return (int)runs.size(); }
+    int GetDrawCallsSaved() const { return cellSegments - (int)runs.size(); }
+};
+
+#endif